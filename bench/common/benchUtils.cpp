@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cstdlib>
+#include "benchUtils.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Splits a list separated by commas.
+/// @param list List to split.
+/// @return The items of the list. Empty items are kept, so they can be
+///         rejected.
+///==============================================================================
+static std::vector<std::string>
+splitList(const std::string& list){
+
+    std::vector<std::string> items { };
+
+    for (std::size_t start= 0; start <= list.size(); ){
+       const std::size_t end { std::min(list.find(',', start), list.size()) };
+
+       items.push_back(list.substr(start, end - start));
+       start= end + 1;
+    }
+
+    return items;
+}
+
+///==============================================================================
+/// @brief Reads a list of sizes, such as 1K,64K,1M,10G.
+/// @param list List of sizes separated by commas.
+/// @param sizes Where the sizes are stored.
+/// @return true whether all the sizes are valid.
+///==============================================================================
+bool
+parseSizes(const std::string& list, std::vector<std::size_t>& sizes){
+
+    sizes.clear();
+
+    for (const std::string& item : splitList(list)){
+       char*       suffix { nullptr };
+       std::size_t size   { std::strtoull(item.c_str(), &suffix, 10) };
+
+       if (*suffix == 'K' || *suffix == 'k')
+          size<<= 10, suffix++;
+       else if (*suffix == 'M' || *suffix == 'm')
+          size<<= 20, suffix++;
+       else if (*suffix == 'G' || *suffix == 'g')
+          size<<= 30, suffix++;
+
+       if (item.empty() || *suffix != '\0' || size == 0)
+          return false;
+
+       sizes.push_back(size);
+    }
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Reads a list of integers, such as 50,80,95.
+/// @param list List of integers separated by commas.
+/// @param min Minimum value of an integer.
+/// @param max Maximum value of an integer.
+/// @param values Where the integers are stored.
+/// @return true whether all the integers are valid.
+///==============================================================================
+bool
+parseIntegers(const std::string& list, const int min, const int max, std::vector<int>& values){
+
+    values.clear();
+
+    for (const std::string& item : splitList(list)){
+       char*      end   { nullptr };
+       const long value { std::strtol(item.c_str(), &end, 10) };
+
+       if (item.empty() || *end != '\0' || value < min || value > max)
+          return false;
+
+       values.push_back(static_cast<int>(value));
+    }
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Reads a list of names, such as en,sp.
+/// @param list List of names separated by commas.
+/// @param valid Names that can be in the list.
+/// @param names Where the names are stored.
+/// @return true whether all the names are valid.
+///==============================================================================
+bool
+parseNames(const std::string& list, const std::vector<std::string>& valid, std::vector<std::string>& names){
+
+    names= splitList(list);
+
+    return std::all_of(names.begin(), names.end(), [&](const std::string& name){ return std::find(valid.begin(), valid.end(), name) != valid.end(); });
+}
+
+///==============================================================================
+/// @brief Gets the text of a size: 1K, 64K, 1M, 10G...
+/// @param size Size in bytes.
+/// @return The size with the largest suffix that divides it.
+///==============================================================================
+std::string
+getSizeName(const std::size_t size){
+
+    if (size % (1 << 30) == 0)
+       return std::to_string(size >> 30) + "G";
+    else if (size % (1 << 20) == 0)
+       return std::to_string(size >> 20) + "M";
+    else if (size % (1 << 10) == 0)
+       return std::to_string(size >> 10) + "K";
+    else
+       return std::to_string(size);
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,15 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace SherpadCaesar{
+
+                    bool   parseSizes(const std::string&, std::vector<std::size_t>&);
+                    bool   parseIntegers(const std::string&, const int, const int, std::vector<int>&);
+                    bool   parseNames(const std::string&, const std::vector<std::string>&, std::vector<std::string>&);
+             std::string   getSizeName(const std::size_t);
+
+} // namespace SherpadCaesar
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "../common/benchUtils.hpp"
+#include "corpusGenerator.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief Size of the blocks written to the corpus file.
+constexpr std::size_t CORPUS_BLOCK_SIZE { 1 << 20 };
+
+///==============================================================================
+/// @brief Constructor of the CorpusGenerator_t class.
+/// @param spec Parameters of the corpus.
+///==============================================================================
+CorpusGenerator_t::CorpusGenerator_t(const CorpusSpec_t& spec)
+    : m_spec { spec }, m_state { spec.seed * 0x9E3779B97F4A7C15ULL + spec.size } {
+
+}
+
+///==============================================================================
+/// @brief Gets the next random number (splitmix64).
+/// @return A random number of 64 bits.
+///==============================================================================
+std::uint64_t
+CorpusGenerator_t::nextRandom() noexcept{
+
+    std::uint64_t z { m_state+= 0x9E3779B97F4A7C15ULL };
+
+    z= (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z= (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return z ^ (z >> 31);
+}
+
+///==============================================================================
+/// @brief Writes the next characters of the corpus.
+/// @param block Where the characters are written.
+/// @param capacity Bytes to write.
+/// @return The number of bytes written, which is always the capacity.
+///==============================================================================
+std::size_t
+CorpusGenerator_t::fill(char* block, const std::size_t capacity) noexcept{
+
+    //Spaces are the most common of the rest of the characters, as between words.
+    static constexpr char OTHERS[] { ' ', ' ', ' ', ' ', ' ', ' ', ',', '.', ';', '0', '1', '7' };
+
+    const bool isSpanish { m_spec.language == "sp" };
+
+    for (std::size_t i= 0; i < capacity; ){
+       const std::uint64_t random  { nextRandom() };
+       const int           kind    { static_cast<int>(random % 100) };
+       const int           enye    { static_cast<int>((random >> 8) % 100) };
+       const bool          isUpper { (random >> 16) % 10 == 0 };
+
+       if (m_column >= m_spec.lineLength){
+          block[i++]= '\n';
+          m_column= 0;
+       }
+       else if (kind >= m_spec.letters)
+          block[i++]= OTHERS[(random >> 24) % sizeof(OTHERS)], m_column++;
+       else if (isSpanish && enye < m_spec.enyes && i + 2 <= capacity){
+          block[i++]= '\xC3';
+          block[i++]= isUpper ? '\x91' : '\xB1';
+          m_column++;
+       }
+       else
+          block[i++]= static_cast<char>((isUpper ? 'A' : 'a') + (random >> 32) % 26), m_column++;
+    }
+
+    return capacity;
+}
+
+///==============================================================================
+/// @brief Writes the whole corpus in a file.
+/// @param path Path of the file.
+/// @return true whether the file was written.
+///==============================================================================
+bool
+CorpusGenerator_t::write(const std::string& path){
+
+    std::FILE*        file  { std::fopen(path.c_str(), "wb") };
+    std::vector<char> block ( CORPUS_BLOCK_SIZE );
+    bool              isOk  { file != nullptr };
+
+    for (std::size_t written= 0; isOk && written < m_spec.size; ){
+       const std::size_t length { fill(block.data(), std::min(CORPUS_BLOCK_SIZE, m_spec.size - written)) };
+
+       isOk= std::fwrite(block.data(), 1, length, file) == length;
+       written+= length;
+    }
+
+    if (file != nullptr)
+       isOk= (std::fclose(file) == 0) && isOk;
+
+    if (!isOk)
+       std::remove(path.c_str());
+
+    return isOk;
+}
+
+///==============================================================================
+/// @brief Gets a name of the corpus made of its parameters, so a corpus
+///        already written can be found and used again.
+/// @return The name, such as sp-16M-l80-n5-w80-s1.txt.
+///==============================================================================
+std::string
+CorpusGenerator_t::getName() const{
+
+    return m_spec.language + "-" + getSizeName(m_spec.size) + "-l" + std::to_string(m_spec.letters) + "-n" + std::to_string(m_spec.enyes) +
+           "-w" + std::to_string(m_spec.lineLength) + "-s" + std::to_string(m_spec.seed) + ".txt";
+}
+
+} // namespace SherpadCaesar
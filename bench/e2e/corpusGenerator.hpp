@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace SherpadCaesar{
+
+/// @brief Parameters of a synthetic corpus. The same parameters always give the same bytes.
+struct CorpusSpec_t{
+                                                              /// @brief Language of the letters: en or sp.
+                                                std::string   language            { "en" };
+
+                                                              /// @brief Size of the corpus in bytes.
+                                                std::size_t   size                { 0 };
+
+                                                              /// @brief Percentage of the characters that are letters. The rest are spaces, punctuation and digits.
+                                                        int   letters             { 80 };
+
+                                                              /// @brief Percentage of the Spanish letters that are 'ñ' or 'Ñ'.
+                                                        int   enyes               { 0 };
+
+                                                              /// @brief Characters of every line, without the line break.
+                                                        int   lineLength          { 80 };
+
+                                                              /// @brief Seed of the random numbers.
+                                              std::uint64_t   seed                { 1 };
+};
+
+/// @class CorpusGenerator_t
+/// @brief Generates a synthetic corpus block by block, so corpora of any size can be written with little memory. A
+///        block never cuts a character: when a character of two bytes doesn't fit at the end, a letter of one byte
+///        takes its place, so the corpus has exactly the size asked for.
+
+    class CorpusGenerator_t{
+        private:
+                                                              /// @brief Parameters of the corpus.
+                                               CorpusSpec_t   m_spec;
+
+                                                              /// @brief State of the random numbers.
+                                              std::uint64_t   m_state;
+
+                                                              /// @brief Characters written in the current line.
+                                                        int   m_column            { 0 };
+
+                                              std::uint64_t   nextRandom()                             noexcept;
+
+        public:
+                explicit                                      CorpusGenerator_t(const CorpusSpec_t&);
+                                                              CorpusGenerator_t(const CorpusGenerator_t&)      = delete;
+                                                              CorpusGenerator_t(      CorpusGenerator_t&&)     = delete;
+                                                             ~CorpusGenerator_t()                              = default;
+                                         CorpusGenerator_t&   operator=(const CorpusGenerator_t&)              = delete;
+                                         CorpusGenerator_t&   operator=(      CorpusGenerator_t&&)             = delete;
+                                                std::size_t   fill(char*, const std::size_t)           noexcept;
+                                                       bool   write(const std::string&);
+                                                std::string   getName()                                const;
+    };
+
+} // namespace SherpadCaesar
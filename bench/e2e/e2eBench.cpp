@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../common/benchUtils.hpp"
+#include "corpusGenerator.hpp"
+#include "processProbe.hpp"
+
+using namespace SherpadCaesar;
+
+/// @brief Level of the modes of a single level.
+constexpr const char* E2E_LEVEL      { "3" };
+
+/// @brief Biggest text that fits in a single argument of the command line (MAX_ARG_STRLEN of Linux, which counts the '\0').
+constexpr std::size_t E2E_MAX_STRING { (128 << 10) - 1 };
+
+/// @brief Options of the command line.
+struct E2EOptions_t{
+                                                              /// @brief Path of the caesar executable.
+                                                std::string   caesar              { "./caesar" };
+
+                                                              /// @brief Directory of the corpora. They are kept, to be used again.
+                                                std::string   directory           { "./benchCorpus" };
+
+                                                              /// @brief Sizes of the corpora in bytes.
+                                   std::vector<std::size_t>   sizes               { 64 << 10, 16 << 20 };
+
+                                                              /// @brief Languages of the corpora.
+                                   std::vector<std::string>   languages           { "en", "sp" };
+
+                                                              /// @brief Percentages of letters of the corpora.
+                                           std::vector<int>   letters             { 80 };
+
+                                                              /// @brief Percentages of 'ñ' of the Spanish letters.
+                                           std::vector<int>   enyes               { 5 };
+
+                                                              /// @brief Lengths of the lines of the corpora.
+                                           std::vector<int>   lineLengths         { 80 };
+
+                                                              /// @brief Paths of the command line run over every corpus.
+                                   std::vector<std::string>   modes               { "string", "file", "stream", "bulk" };
+
+                                                              /// @brief Runs of every measure. The fastest one is kept.
+                                                        int   repeat              { 3 };
+
+                                                              /// @brief Seed of the corpora.
+                                                        int   seed                { 1 };
+
+                                                              /// @brief Where the report is written as JSON. Empty if it isn't.
+                                                std::string   jsonPath            { };
+
+                                                              /// @brief Indicates whether the system calls are counted.
+                                                       bool   countSyscalls       { true };
+};
+
+/// @brief Measures of a path of the command line over a corpus.
+struct E2EResult_t{
+                                                              /// @brief Parameters of the corpus.
+                                               CorpusSpec_t   spec                { };
+
+                                                              /// @brief Path of the command line.
+                                                std::string   mode                { };
+
+                                                              /// @brief Measures of the fastest run, with the system calls of the traced one.
+                                            ProcessResult_t   measures            { };
+};
+
+///==============================================================================
+/// @brief Reads the options of the command line.
+/// @param nArgs Number of arguments.
+/// @param sArgs Arguments.
+/// @param options Where the options are stored.
+/// @return true whether the options are valid.
+///==============================================================================
+static bool
+parseOptions(const int nArgs, const char* sArgs[], E2EOptions_t& options){
+
+    std::vector<int> values { };
+
+    for (int i= 1; i < nArgs; i++){
+       const std::string option { sArgs[i] };
+
+       if (option == "--no-syscalls"){
+          options.countSyscalls= false;
+          continue;
+       }
+
+       if (i + 1 >= nArgs)
+          return false;
+
+       const std::string value { sArgs[++i] };
+
+       if (option == "--caesar")
+          options.caesar= value;
+       else if (option == "--dir")
+          options.directory= value;
+       else if (option == "--json")
+          options.jsonPath= value;
+       else if (option == "--sizes" && parseSizes(value, options.sizes))
+          continue;
+       else if (option == "--languages" && parseNames(value, { "en", "sp" }, options.languages))
+          continue;
+       else if (option == "--modes" && parseNames(value, { "string", "file", "stream", "bulk" }, options.modes))
+          continue;
+       else if (option == "--letters" && parseIntegers(value, 0, 100, options.letters))
+          continue;
+       else if (option == "--enyes" && parseIntegers(value, 0, 100, options.enyes))
+          continue;
+       else if (option == "--line-length" && parseIntegers(value, 1, 1 << 20, options.lineLengths))
+          continue;
+       else if (option == "--repeat" && parseIntegers(value, 1, 100, values))
+          options.repeat= values.front();
+       else if (option == "--seed" && parseIntegers(value, 0, 1 << 30, values))
+          options.seed= values.front();
+       else
+          return false;
+    }
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Gets the path of a corpus, writing it if it isn't in the directory
+///        yet.
+/// @param options Options of the command line.
+/// @param spec Parameters of the corpus.
+/// @return The path of the corpus, or empty if it couldn't be written.
+///==============================================================================
+static std::string
+prepareCorpus(const E2EOptions_t& options, const CorpusSpec_t& spec){
+
+    CorpusGenerator_t generator { spec };
+    const std::string path      { options.directory + "/" + generator.getName() };
+    struct stat       status    { };
+
+    if (stat(path.c_str(), &status) == 0 && static_cast<std::size_t>(status.st_size) == spec.size)
+       return path;
+
+    std::printf("[+] Writing the corpus %s...\n", path.c_str());
+    std::fflush(stdout);
+
+    return generator.write(path) ? path : std::string { };
+}
+
+///==============================================================================
+/// @brief Gets the command line of a path over a corpus.
+/// @param options Options of the command line.
+/// @param spec Parameters of the corpus.
+/// @param mode Path of the command line.
+/// @param path Path of the corpus.
+/// @return The command and its arguments, or empty if the mode can't be run
+///         over the corpus.
+///==============================================================================
+static std::vector<std::string>
+getCommand(const E2EOptions_t& options, const CorpusSpec_t& spec, const std::string& mode, const std::string& path){
+
+    std::vector<std::string> command { options.caesar, "-e", "-k", spec.language };
+
+    if (mode == "string"){
+       std::ifstream file { path, std::ios::binary };
+
+       if (spec.size > E2E_MAX_STRING)
+          return { };
+
+       command.insert(command.end(), { "-l", E2E_LEVEL, "-s", std::string { std::istreambuf_iterator<char> { file }, { } } });
+    }
+    else if (mode == "file")
+       command.insert(command.end(), { "-l", E2E_LEVEL, "-f", path });
+    else if (mode == "stream")
+       command.insert(command.end(), { "-l", E2E_LEVEL, "-f", path, "--stream" });
+    else
+       command.insert(command.end(), { "-f", path });
+
+    return command;
+}
+
+///==============================================================================
+/// @brief Checks whether a run ended well, so its measures are valid.
+/// @param measures Measures of the run.
+/// @return true whether the process exited with 0 and its time was taken.
+///==============================================================================
+static bool
+isSuccessful(const ProcessResult_t& measures){
+
+    return measures.exitStatus == 0 && measures.wallSeconds > 0.0;
+}
+
+///==============================================================================
+/// @brief Writes the report as JSON, one measure per line. The throughput of a
+///        mode whose runs all failed is null.
+/// @param path Path of the JSON file.
+/// @param results Measures to write.
+/// @return true whether the file was written.
+///==============================================================================
+static bool
+writeJson(const std::string& path, const std::vector<E2EResult_t>& results){
+
+    std::ofstream file { path, std::ios::trunc };
+    char          line[512];
+    char          throughput[32];
+
+    file << "{\n  \"runs\": [\n";
+
+    for (std::size_t i= 0; i < results.size(); i++){
+       const E2EResult_t& r { results[i] };
+
+       if (isSuccessful(r.measures))
+          std::snprintf(throughput, sizeof(throughput), "%.3f", r.spec.size / r.measures.wallSeconds / 1e6);
+       else
+          std::snprintf(throughput, sizeof(throughput), "null");
+
+       std::snprintf(line, sizeof(line), "    {\"mode\": \"%s\", \"language\": \"%s\", \"bytes\": %zu, \"letters\": %d, \"enyes\": %d, \"line_length\": %d, "
+                     "\"seed\": %llu, \"wall_s\": %.6f, \"mb_per_s\": %s, \"max_rss_kb\": %ld, \"syscalls\": %lld, \"exit_status\": %d}%s\n",
+                     r.mode.c_str(), r.spec.language.c_str(), r.spec.size, r.spec.letters, r.spec.enyes, r.spec.lineLength,
+                     static_cast<unsigned long long>(r.spec.seed), r.measures.wallSeconds, throughput,
+                     r.measures.maxRssKb, r.measures.syscalls, r.measures.exitStatus, i + 1 < results.size() ? "," : "");
+       file << line;
+    }
+
+    file << "  ]\n}\n";
+
+    return static_cast<bool>(file.flush());
+}
+
+int main(const int nArgs, const char* sArgs[]){
+
+    E2EOptions_t             options { };
+    ProcessProbe_t           probe   { };
+    std::vector<E2EResult_t> results { };
+
+    if (!parseOptions(nArgs, sArgs, options)){
+       std::fprintf(stderr, "Usage: %s [--caesar PATH] [--dir DIR] [--sizes 64K,16M,1G] [--languages en,sp] [--letters 50,80] [--enyes 5] "
+                            "[--line-length 80] [--modes string,file,stream,bulk] [--repeat N] [--seed N] [--json FILE] [--no-syscalls]\n", sArgs[0]);
+
+       return 2;
+    }
+
+    if (access(options.caesar.c_str(), X_OK) != 0 || (mkdir(options.directory.c_str(), 0755) != 0 && errno != EEXIST)){
+       std::fprintf(stderr, "[-] %s can't be run or the directory %s can't be created.\n", options.caesar.c_str(), options.directory.c_str());
+
+       return 2;
+    }
+
+    for (const std::string& language : options.languages)
+       for (const std::size_t size : options.sizes)
+          for (const int letters : options.letters)
+             for (const int enyes : language == "sp" ? options.enyes : std::vector<int> { 0 })
+                for (const int lineLength : options.lineLengths){
+                   const CorpusSpec_t spec { language, size, letters, enyes, lineLength, static_cast<std::uint64_t>(options.seed) };
+                   const std::string  path { prepareCorpus(options, spec) };
+
+                   if (path.empty()){
+                      std::fprintf(stderr, "[-] The corpus of %s couldn't be written in %s.\n", getSizeName(size).c_str(), options.directory.c_str());
+
+                      return 2;
+                   }
+
+                   for (const std::string& mode : options.modes){
+                      const std::vector<std::string> command { getCommand(options, spec, mode, path) };
+                            E2EResult_t              result  { spec, mode };
+
+                      if (command.empty())
+                         continue;
+
+                      for (int run= 0; run < options.repeat; run++){
+                         const ProcessResult_t measures { probe.run(command) };
+
+                         //A failed run is only kept while no run has succeeded, so its status is reported.
+                         if (run == 0 || (isSuccessful(measures) && (!isSuccessful(result.measures) || measures.wallSeconds < result.measures.wallSeconds)))
+                            result.measures= measures;
+                      }
+
+                      if (options.countSyscalls)
+                         result.measures.syscalls= probe.countSyscalls(command);
+
+                      if (isSuccessful(result.measures))
+                         std::printf("[+] %-6s %s %5s l%-3d n%-3d w%-5d %9.4f s %9.1f MB/s %9ld KB %9lld syscalls\n", mode.c_str(), language.c_str(),
+                                     getSizeName(size).c_str(), letters, enyes, lineLength, result.measures.wallSeconds, size / result.measures.wallSeconds / 1e6,
+                                     result.measures.maxRssKb, result.measures.syscalls);
+                      else
+                         std::printf("[+] %-6s %s %5s l%-3d n%-3d w%-5d %9s   %9s      %9ld KB %9lld syscalls  FAILED (exit status %d)\n", mode.c_str(),
+                                     language.c_str(), getSizeName(size).c_str(), letters, enyes, lineLength, "-", "-", result.measures.maxRssKb,
+                                     result.measures.syscalls, result.measures.exitStatus);
+                      std::fflush(stdout);
+
+                      results.push_back(std::move(result));
+                   }
+                }
+
+    if (options.countSyscalls && !probe.canTrace())
+       std::printf("[+] \n[+] ptrace() isn't allowed here, so the system calls weren't counted (-1).\n");
+
+    if (!options.jsonPath.empty() && !writeJson(options.jsonPath, results)){
+       std::fprintf(stderr, "[-] The report couldn't be written in %s.\n", options.jsonPath.c_str());
+
+       return 2;
+    }
+
+    return 0;
+}
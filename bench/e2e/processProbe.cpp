@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <chrono>
+#include <csignal>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/ptrace.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "processProbe.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief Exit status of the child when it can't be traced.
+constexpr int PROBE_NO_TRACE_STATUS { 126 };
+
+/// @brief Exit status of the child when the command can't be run.
+constexpr int PROBE_NO_EXEC_STATUS  { 127 };
+
+///==============================================================================
+/// @brief Starts the command in the child: sends its output to /dev/null and
+///        replaces the child with it. Never returns.
+/// @param args Command and its arguments.
+///==============================================================================
+[[noreturn]] static void
+execCommand(const std::vector<std::string>& args){
+
+    std::vector<char*> argv { };
+    const int          null { open("/dev/null", O_WRONLY) };
+
+    for (const std::string& arg : args)
+       argv.push_back(const_cast<char*>(arg.c_str()));
+
+    argv.push_back(nullptr);
+
+    if (null >= 0){
+       dup2(null, STDOUT_FILENO);
+       dup2(null, STDERR_FILENO);
+    }
+
+    execv(argv[0], argv.data());
+    _exit(PROBE_NO_EXEC_STATUS);
+}
+
+///==============================================================================
+/// @brief Runs a command and measures its time and its peak memory.
+/// @param args Command and its arguments. The command is a path.
+/// @return The measures. The system calls aren't counted.
+///==============================================================================
+ProcessResult_t
+ProcessProbe_t::run(const std::vector<std::string>& args) const{
+
+    using Clock_t= std::chrono::steady_clock;
+
+    ProcessResult_t           result { };
+    struct rusage             usage  { };
+    int                       status { 0 };
+    const Clock_t::time_point start  { Clock_t::now() };
+    const pid_t               pid    { fork() };
+
+    if (pid == 0)
+       execCommand(args);
+
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+       return result;
+
+    result.wallSeconds= std::chrono::duration<double>(Clock_t::now() - start).count();
+    result.maxRssKb   = usage.ru_maxrss;
+    result.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    return result;
+}
+
+///==============================================================================
+/// @brief Runs a command under ptrace() and counts the system calls of all its
+///        threads. Every thread stops at the entry and at the exit of every
+///        call, so only the entries are counted.
+/// @param args Command and its arguments. The command is a path.
+/// @return The number of system calls, or -1 if they couldn't be counted.
+///==============================================================================
+long long
+ProcessProbe_t::countSyscalls(const std::vector<std::string>& args){
+
+    std::unordered_map<pid_t, bool> inSyscall { };
+    long long                       syscalls  { 0 };
+    int                             status    { 0 };
+    bool                            isTraced  { false };
+
+    if (!m_canTrace)
+       return -1;
+
+    const pid_t pid { fork() };
+
+    if (pid == 0){
+       if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0)
+          _exit(PROBE_NO_TRACE_STATUS);
+
+       raise(SIGSTOP);
+       execCommand(args);
+    }
+
+    if (pid < 0 || waitpid(pid, &status, 0) != pid)
+       return -1;
+
+    if (WIFSTOPPED(status)){
+       const long options { PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEFORK | PTRACE_O_TRACEVFORK | PTRACE_O_TRACEEXEC | PTRACE_O_EXITKILL };
+
+       isTraced= ptrace(PTRACE_SETOPTIONS, pid, nullptr, options) == 0 && ptrace(PTRACE_SYSCALL, pid, nullptr, nullptr) == 0;
+       inSyscall[pid]= false;
+    }
+
+    if (!isTraced){
+       m_canTrace= false;
+
+       if (WIFSTOPPED(status))
+          kill(pid, SIGKILL);
+
+       waitpid(pid, &status, 0);
+
+       return -1;
+    }
+
+    //Every stop of every thread ends here, until the last one exits.
+    for (pid_t thread; (thread= waitpid(-1, &status, __WALL)) > 0; ){
+       int signal { 0 };
+
+       if (!WIFSTOPPED(status)){
+          inSyscall.erase(thread);
+          continue;
+       }
+
+       const int  stopSignal { WSTOPSIG(status) };
+       const bool isNew      { inSyscall.find(thread) == inSyscall.end() };
+             bool& isInside  { inSyscall[thread] };
+
+       if (stopSignal == (SIGTRAP | 0x80)){
+          syscalls+= !isInside;
+          isInside= !isInside;
+       }
+       else if (stopSignal != SIGTRAP && !(stopSignal == SIGSTOP && isNew)){
+          //The events of clone and exec, and the first stop of a new thread, aren't signals of the command.
+          signal= stopSignal;
+       }
+
+       ptrace(PTRACE_SYSCALL, thread, nullptr, signal);
+    }
+
+    return syscalls;
+}
+
+///==============================================================================
+/// @brief Indicates whether the system calls can be counted. It is known after
+///        the first call to countSyscalls().
+/// @return m_canTrace that indicates whether ptrace() can be used.
+///==============================================================================
+bool
+ProcessProbe_t::canTrace() const noexcept{
+
+    return m_canTrace;
+}
+
+} // namespace SherpadCaesar
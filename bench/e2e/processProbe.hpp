@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @brief Measures of a run of a process.
+struct ProcessResult_t{
+                                                              /// @brief Time from the start of the process to its end, in seconds.
+                                                     double   wallSeconds         { 0.0 };
+
+                                                              /// @brief Peak resident set size of the process, in kilobytes.
+                                                       long   maxRssKb            { 0 };
+
+                                                              /// @brief System calls made by all the threads of the process. -1 if they weren't counted.
+                                                  long long   syscalls            { -1 };
+
+                                                              /// @brief Exit status of the process. -1 if it didn't exit normally.
+                                                        int   exitStatus          { -1 };
+};
+
+/// @class ProcessProbe_t
+/// @brief Runs a command with its standard output and error sent to /dev/null, and measures it. The time and the peak
+///        memory come from wait4(); the system calls are counted in a second run under ptrace(), since stopping at
+///        every call slows the process down. If ptrace() isn't allowed, as in some containers, the calls aren't
+///        counted and the rest of the measures are still taken.
+
+    class ProcessProbe_t{
+        private:
+                                                              /// @brief Indicates whether ptrace() can be used.
+                                                       bool   m_canTrace          { true };
+
+        public:
+                                                              ProcessProbe_t()                                 = default;
+                                                              ProcessProbe_t(const ProcessProbe_t&)            = delete;
+                                                              ProcessProbe_t(      ProcessProbe_t&&)           = delete;
+                                                             ~ProcessProbe_t()                                 = default;
+                                            ProcessProbe_t&   operator=(const ProcessProbe_t&)                 = delete;
+                                            ProcessProbe_t&   operator=(      ProcessProbe_t&&)                = delete;
+                                            ProcessResult_t   run(const std::vector<std::string>&)       const;
+                                                  long long   countSyscalls(const std::vector<std::string>&);
+                                                       bool   canTrace()                                 const noexcept;
+    };
+
+} // namespace SherpadCaesar
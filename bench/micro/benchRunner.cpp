@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include "benchRunner.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief Rounds of every benchmark. The fastest one is kept.
+constexpr int BENCH_ROUNDS { 3 };
+
+/// @brief Where the checksums of the kernels go, so the compiler can't drop their work.
+static volatile std::size_t benchSink { 0 };
+
+///==============================================================================
+/// @brief Constructor of the BenchRunner_t class.
+/// @param minTime Minimum time of a round in milliseconds.
+/// @param filter Only the benchmarks whose name contains it are run. Empty
+///        runs them all.
+///==============================================================================
+BenchRunner_t::BenchRunner_t(const double minTime, const std::string_view filter)
+    : m_minTime { minTime * 1e6 }, m_filter { filter } {
+
+}
+
+///==============================================================================
+/// @brief Indicates whether a benchmark has to be run, so its data isn't built
+///        when it doesn't.
+/// @param name Name of the benchmark, or a part of it.
+/// @return true whether the filter is empty or the name contains it.
+///==============================================================================
+bool
+BenchRunner_t::isSelected(const std::string_view name) const noexcept{
+
+    return m_filter.empty() || name.find(m_filter) != std::string_view::npos;
+}
+
+///==============================================================================
+/// @brief Times a benchmark and prints its result.
+/// @param name Name of the benchmark.
+/// @param bytes Bytes processed by every call of the kernel.
+/// @param kernel Does the work once and returns a checksum of it.
+///==============================================================================
+void
+BenchRunner_t::run(const std::string& name, const std::size_t bytes, const std::function<std::size_t()>& kernel){
+
+    using Clock_t= std::chrono::steady_clock;
+
+    BenchResult_t result    { name, bytes };
+    double        bestTime  { -1.0 };
+
+    if (!isSelected(name))
+       return;
+
+    //The first call warms up the caches and the branch predictor.
+    benchSink= benchSink + kernel();
+
+    for (int round= 0; round < BENCH_ROUNDS; round++){
+       std::size_t iterations { 0 };
+       double      elapsed    { 0.0 };
+
+       const Clock_t::time_point start { Clock_t::now() };
+
+       do{
+          benchSink= benchSink + kernel();
+          iterations++;
+          elapsed= std::chrono::duration<double, std::nano>(Clock_t::now() - start).count();
+       }while (elapsed < m_minTime);
+
+       if (bestTime < 0.0 || elapsed / iterations < bestTime){
+          bestTime= elapsed / iterations;
+          result.iterations= iterations;
+       }
+    }
+
+    result.nsPerByte  = bestTime / static_cast<double>(std::max<std::size_t>(bytes, 1));
+    result.mbPerSecond= 1e3 / result.nsPerByte;
+
+    std::printf("[+] %-44s %10.3f ns/byte %10.1f MB/s\n", name.c_str(), result.nsPerByte, result.mbPerSecond);
+    std::fflush(stdout);
+
+    m_results.push_back(std::move(result));
+}
+
+///==============================================================================
+/// @brief Gets the results of the benchmarks run.
+/// @return m_results that contains the results, in the order they were run.
+///==============================================================================
+const std::vector<BenchResult_t>&
+BenchRunner_t::getResults() const noexcept{
+
+    return m_results;
+}
+
+///==============================================================================
+/// @brief Writes the results as JSON, one benchmark per line.
+/// @param path Path of the JSON file.
+/// @return true whether the file was written.
+///==============================================================================
+bool
+BenchRunner_t::writeJson(const std::string& path) const{
+
+    std::ofstream file { path, std::ios::trunc };
+    char          line[512];
+
+    file << "{\n  \"benchmarks\": [\n";
+
+    for (std::size_t i= 0; i < m_results.size(); i++){
+       const BenchResult_t& result { m_results[i] };
+
+       std::snprintf(line, sizeof(line), "    {\"name\": \"%s\", \"bytes\": %zu, \"iterations\": %zu, \"ns_per_byte\": %.6f, \"mb_per_s\": %.3f}%s\n",
+                     result.name.c_str(), result.bytes, result.iterations, result.nsPerByte, result.mbPerSecond, i + 1 < m_results.size() ? "," : "");
+       file << line;
+    }
+
+    file << "  ]\n}\n";
+
+    return static_cast<bool>(file.flush());
+}
+
+///==============================================================================
+/// @brief Compares the results against the ones of an earlier run and prints
+///        the change of every benchmark run in both.
+/// @param baseline Results of the earlier run.
+/// @param threshold Percentage by which a benchmark has to get slower to be a
+///        regression.
+/// @return The number of regressions.
+///==============================================================================
+std::size_t
+BenchRunner_t::compare(const std::vector<BenchResult_t>& baseline, const double threshold) const{
+
+    std::size_t regressions { 0 };
+    std::size_t compared    { 0 };
+
+    for (const BenchResult_t& result : m_results){
+       const auto old { std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult_t& b){ return b.name == result.name; }) };
+
+       if (old == baseline.end() || old->nsPerByte <= 0.0)
+          continue;
+
+       const double change       { (result.nsPerByte / old->nsPerByte - 1.0) * 100.0 };
+       const bool   isRegression { change > threshold };
+
+       compared++;
+       regressions+= isRegression;
+       std::printf("[+] %-44s %10.3f -> %10.3f ns/byte %+7.1f%%%s\n", result.name.c_str(), old->nsPerByte, result.nsPerByte, change, isRegression ? "  REGRESSION" : "");
+    }
+
+    std::printf("[+] \n[+] %zu of %zu benchmarks are more than %.1f%% slower than the baseline.\n", regressions, compared, threshold);
+
+    return regressions;
+}
+
+///==============================================================================
+/// @brief Reads the results written by writeJson().
+/// @param path Path of the JSON file.
+/// @return The name and the nanoseconds per byte of every benchmark of the file.
+///         Empty if it can't be read.
+///==============================================================================
+std::vector<BenchResult_t>
+BenchRunner_t::readJson(const std::string& path){
+
+    constexpr std::string_view NAME_KEY        { "\"name\": \"" };
+    constexpr std::string_view NS_PER_BYTE_KEY { "\"ns_per_byte\": " };
+
+    std::ifstream              file    { path };
+    std::string                line    { };
+    std::vector<BenchResult_t> results { };
+
+    while (std::getline(file, line)){
+       const std::size_t name       { line.find(NAME_KEY) };
+       const std::size_t nsPerByte  { line.find(NS_PER_BYTE_KEY) };
+
+       if (name == std::string::npos || nsPerByte == std::string::npos)
+          continue;
+
+       const std::size_t nameStart { name + NAME_KEY.size() };
+             BenchResult_t result  { };
+
+       result.name     = line.substr(nameStart, line.find('"', nameStart) - nameStart);
+       result.nsPerByte= std::strtod(line.c_str() + nsPerByte + NS_PER_BYTE_KEY.size(), nullptr);
+       results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+} // namespace SherpadCaesar
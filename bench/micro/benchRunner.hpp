@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @brief Result of a benchmark.
+struct BenchResult_t{
+                                                              /// @brief Name of the benchmark: kernel/alphabet/density/size.
+                                                std::string   name                { };
+
+                                                              /// @brief Bytes processed by every iteration.
+                                                std::size_t   bytes               { 0 };
+
+                                                              /// @brief Iterations of the fastest round.
+                                                std::size_t   iterations          { 0 };
+
+                                                              /// @brief Nanoseconds per byte of the fastest round.
+                                                     double   nsPerByte           { 0.0 };
+
+                                                              /// @brief Megabytes (10^6 bytes) per second of the fastest round.
+                                                     double   mbPerSecond         { 0.0 };
+};
+
+/// @class BenchRunner_t
+/// @brief Times the benchmarks of the kernels. Every benchmark is repeated until a round lasts the minimum time, and
+///        the fastest of several rounds is kept, since the noise of the machine only makes a round slower. The results
+///        can be written as JSON and compared against the JSON of an earlier run.
+
+    class BenchRunner_t{
+        private:
+                                                              /// @brief Minimum time of a round in nanoseconds.
+                                                     double   m_minTime;
+
+                                                              /// @brief Only the benchmarks whose name contains it are run.
+                                                std::string   m_filter;
+
+                                                              /// @brief Results of the benchmarks run.
+                                 std::vector<BenchResult_t>   m_results           { };
+
+        public:
+                                                              BenchRunner_t(const double, const std::string_view);
+                                                              BenchRunner_t(const BenchRunner_t&)              = delete;
+                                                              BenchRunner_t(      BenchRunner_t&&)             = delete;
+                                                             ~BenchRunner_t()                                  = default;
+                                             BenchRunner_t&   operator=(const BenchRunner_t&)                  = delete;
+                                             BenchRunner_t&   operator=(      BenchRunner_t&&)                 = delete;
+                                                       bool   isSelected(const std::string_view)         const noexcept;
+                                                       void   run(const std::string&, const std::size_t, const std::function<std::size_t()>&);
+                           const std::vector<BenchResult_t>&  getResults()                               const noexcept;
+                                                       bool   writeJson(const std::string&)              const;
+                                                std::size_t   compare(const std::vector<BenchResult_t>&, const double) const;
+            static               std::vector<BenchResult_t>   readJson(const std::string&);
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "app/dat/args/arguments.hpp"
+#include "app/dat/data.hpp"
+#include "app/eng/bulkTransformer.hpp"
+#include "app/eng/engine.hpp"
+#include "../common/benchUtils.hpp"
+#include "benchRunner.hpp"
+
+using namespace SherpadCaesar;
+
+/// @brief Level of the benchmarks of a single level.
+constexpr int BENCH_LEVEL { 3 };
+
+/// @brief Percentages of letters of the texts.
+constexpr int BENCH_DENSITIES[] { 10, 50, 90 };
+
+/// @brief Kernels timed, in the order they are run.
+constexpr const char* BENCH_KERNELS[] { "legacy", "findCharacterData", "getEncryptedCharacter", "getDecryptedCharacter", "transform-scalar", "transform-auto", "bulk" };
+
+/// @brief Options of the command line.
+struct BenchOptions_t{
+                                                              /// @brief Sizes of the texts in bytes.
+                                   std::vector<std::size_t>   sizes               { 1 << 10, 64 << 10, 1 << 20 };
+
+                                                              /// @brief Only the benchmarks whose name contains it are run.
+                                                std::string   filter              { };
+
+                                                              /// @brief Minimum time of a round in milliseconds.
+                                                     double   minTime             { 50.0 };
+
+                                                              /// @brief Where the results are written as JSON. Empty if they aren't.
+                                                std::string   jsonPath            { };
+
+                                                              /// @brief JSON of an earlier run to compare against. Empty if there isn't.
+                                                std::string   baselinePath        { };
+
+                                                              /// @brief Percentage by which a benchmark has to get slower to be a regression.
+                                                     double   threshold           { 10.0 };
+};
+
+///==============================================================================
+/// @brief Builds a reproducible text of random words. The letters are
+///        uppercase one time in ten and, in Spanish, 'ñ' or 'Ñ' one time in
+///        twenty; the rest of the characters are spaces, punctuation, digits,
+///        accented vowels and line breaks.
+/// @param language Language of the letters.
+/// @param density Percentage of the characters that are letters.
+/// @param size Size of the text in bytes. The last character isn't cut, so the
+///        text can be a few bytes shorter.
+/// @return The text.
+///==============================================================================
+static std::string
+makeText(const Language_t language, const int density, const std::size_t size){
+
+    static constexpr const char* OTHERS[] { " ", " ", " ", ",", ".", ";", "0", "7", "\n", "á", "é", "¿" };
+
+    std::mt19937                       random   { static_cast<std::mt19937::result_type>(size * 131 + density * 7 + language) };
+    std::uniform_int_distribution<int> percent  { 0, 99 };
+    std::uniform_int_distribution<int> letter   { 0, 25 };
+    std::uniform_int_distribution<int> other    { 0, static_cast<int>(std::size(OTHERS)) - 1 };
+    std::string                        text     { };
+    std::string                        c        { };
+
+    text.reserve(size);
+
+    while (true){
+       if (percent(random) >= density)
+          c= OTHERS[other(random)];
+       else if (language == spanishLanguage && percent(random) < 5)
+          c= percent(random) < 10 ? "Ñ" : "ñ";
+       else
+          c= std::string(1, static_cast<char>((percent(random) < 10 ? 'A' : 'a') + letter(random)));
+
+       if (text.size() + c.size() > size)
+          break;
+
+       text+= c;
+    }
+
+    return text;
+}
+
+///==============================================================================
+/// @brief Reads the options of the command line.
+/// @param nArgs Number of arguments.
+/// @param sArgs Arguments.
+/// @param options Where the options are stored.
+/// @return true whether the options are valid.
+///==============================================================================
+static bool
+parseOptions(const int nArgs, const char* sArgs[], BenchOptions_t& options){
+
+    for (int i= 1; i < nArgs; i++){
+       const std::string option { sArgs[i] };
+
+       if (i + 1 >= nArgs)
+          return false;
+
+       const std::string value { sArgs[++i] };
+
+       if (option == "--sizes" && parseSizes(value, options.sizes))
+          continue;
+       else if (option == "--filter")
+          options.filter= value;
+       else if (option == "--min-time" && std::atof(value.c_str()) > 0.0)
+          options.minTime= std::atof(value.c_str());
+       else if (option == "--json")
+          options.jsonPath= value;
+       else if (option == "--baseline")
+          options.baselinePath= value;
+       else if (option == "--threshold" && std::atof(value.c_str()) >= 0.0)
+          options.threshold= std::atof(value.c_str());
+       else
+          return false;
+    }
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Runs the benchmarks of the kernels over a text.
+/// @param runner Runner of the benchmarks.
+/// @param data Data of the language, for the kernels of a character.
+/// @param language Language of the text.
+/// @param text Text to transform.
+/// @param suffix End of the names of the benchmarks: alphabet/density/size.
+///==============================================================================
+static void
+runKernels(BenchRunner_t& runner, const Data_t& data, const Language_t language, const std::string& text, const std::string& suffix){
+
+    const Engine_t          scalar    { language, encryptDirection, BENCH_LEVEL, scalarIsa };
+    const Engine_t          automatic { language, encryptDirection, BENCH_LEVEL };
+    const int               maxLevel  { language == spanishLanguage ? MAX_LEVEL_SPANISH : MAX_LEVEL_ENGLISH };
+          std::vector<char> output    ( automatic.getMaxOutputLength(text.size()) );
+          std::vector<int>  levels    { };
+    //Letters of the text as alphabet and position, for the kernels that only shift.
+          std::vector<std::pair<const Alphabet_t*, int>> letters { };
+
+    for (int level= MIN_LEVEL; level <= maxLevel; level++)
+       levels.push_back(level);
+
+    const BulkTransformer_t bulk { language, encryptDirection, levels };
+
+    for (std::size_t i= 0; i < text.size(); ){
+       const int       length { data.getUTF8CharLength(static_cast<unsigned char>(text[i])) };
+       DataCharacter_t dC     { };
+
+       if (data.findCharacterData(text.substr(i, length), dC))
+          letters.emplace_back(dC.type == capitalLetter ? &data.getAlphabetUppercase() : &data.getAlphabetLowercase(), dC.position);
+
+       i+= length;
+    }
+
+    //=== LAMBDA legacy: the loop of a character at a time that the engine replaced ===
+    runner.run("legacy/" + suffix, text.size(), [&](){
+        std::string transformed { };
+
+        for (std::size_t i= 0; i < text.size(); ){
+           const int             length { data.getUTF8CharLength(static_cast<unsigned char>(text[i])) };
+           const std::string     c      { text.substr(i, length) };
+                 DataCharacter_t dC     { };
+
+           data.findCharacterData(c, dC);
+
+           if (dC.type == capitalLetter)
+              transformed+= data.getTransformedCharacter(data.getAlphabetUppercase(), dC.position, BENCH_LEVEL);
+           else if (dC.type == smallLetter)
+              transformed+= data.getTransformedCharacter(data.getAlphabetLowercase(), dC.position, BENCH_LEVEL);
+           else
+              transformed+= c;
+
+           i+= length;
+        }
+
+        return transformed.size();
+    });
+
+    //=== LAMBDA findCharacterData ===
+    runner.run("findCharacterData/" + suffix, text.size(), [&](){
+        std::size_t found { 0 };
+
+        for (std::size_t i= 0; i < text.size(); ){
+           const int       length { data.getUTF8CharLength(static_cast<unsigned char>(text[i])) };
+           DataCharacter_t dC     { };
+
+           found+= data.findCharacterData(text.substr(i, length), dC);
+           i+= length;
+        }
+
+        return found;
+    });
+
+    //=== LAMBDA getEncryptedCharacter ===
+    runner.run("getEncryptedCharacter/" + suffix, text.size(), [&](){
+        std::size_t length { 0 };
+
+        for (const auto& [alphabet, position] : letters)
+           length+= data.getEncryptedCharacter(*alphabet, position, BENCH_LEVEL).size();
+
+        return length;
+    });
+
+    //=== LAMBDA getDecryptedCharacter ===
+    runner.run("getDecryptedCharacter/" + suffix, text.size(), [&](){
+        std::size_t length { 0 };
+
+        for (const auto& [alphabet, position] : letters)
+           length+= data.getDecryptedCharacter(*alphabet, position, -BENCH_LEVEL).size();
+
+        return length;
+    });
+
+    runner.run("transform-scalar/" + suffix, text.size(), [&](){ return scalar.transform(text, output.data()); });
+    runner.run("transform-auto/" + suffix, text.size(), [&](){ return automatic.transform(text, output.data()); });
+
+    //=== LAMBDA bulk: every level, so the bytes are the ones of the text times the levels ===
+    runner.run("bulk/" + suffix, text.size() * levels.size(), [&](){
+        std::size_t written { 0 };
+
+        bulk.run(text, LevelOutput_t { [](const int){ }, [&](const char*, const std::size_t length){ written+= length; }, [](const int){ } });
+
+        return written;
+    });
+}
+
+int main(const int nArgs, const char* sArgs[]){
+
+    BenchOptions_t options { };
+
+    if (!parseOptions(nArgs, sArgs, options)){
+       std::fprintf(stderr, "Usage: %s [--sizes 1K,64K,1M] [--filter TEXT] [--min-time MS] [--json FILE] [--baseline FILE] [--threshold PERCENT]\n", sArgs[0]);
+
+       return 2;
+    }
+
+    std::vector<BenchResult_t> baseline { };
+
+    if (!options.baselinePath.empty() && (baseline= BenchRunner_t::readJson(options.baselinePath)).empty()){
+       std::fprintf(stderr, "[-] The baseline %s has no results.\n", options.baselinePath.c_str());
+
+       return 2;
+    }
+
+    const char*   noArguments[] { sArgs[0] };
+    Arguments_t   arguments     { 1, noArguments };
+    BenchRunner_t runner        { options.minTime, options.filter };
+
+    for (const Language_t language : { englishLanguage, spanishLanguage }){
+       Data_t data { arguments };
+
+       data.setLanguage(language);
+
+       for (const int density : BENCH_DENSITIES)
+          for (const std::size_t size : options.sizes){
+             const std::string suffix     { std::string(language == spanishLanguage ? "sp" : "en") + "/d" + std::to_string(density) + "/" + getSizeName(size) };
+                   bool        isSelected { false };
+
+             //The text is only built if a kernel runs over it.
+             for (const char* kernel : BENCH_KERNELS)
+                isSelected= isSelected || runner.isSelected(kernel + ("/" + suffix));
+
+             if (isSelected)
+                runKernels(runner, data, language, makeText(language, density, size), suffix);
+          }
+    }
+
+    if (!options.jsonPath.empty() && !runner.writeJson(options.jsonPath)){
+       std::fprintf(stderr, "[-] The results couldn't be written in %s.\n", options.jsonPath.c_str());
+
+       return 2;
+    }
+
+    if (!baseline.empty()){
+       std::printf("[+] \n");
+
+       if (runner.compare(baseline, options.threshold) > 0)
+          return 1;
+    }
+
+    return 0;
+}
@@ -1,9 +1,25 @@
 // SPDX-License-Identifier: GPL-v3.0
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <unistd.h>
 #include "dat/data.hpp"
+#include "dat/excep/caesarException.hpp"
+#include "dat/utils/utf8.hpp"
+#include "eng/batchTransformer.hpp"
+#include "eng/cribIndex.hpp"
+#include "eng/directoryMirror.hpp"
+#include "io/blockReader.hpp"
+#include "io/sharedMapping.hpp"
+#include "stats/allocationCounter.hpp"
+#include "stats/stageProfile.hpp"
+#include "trace/probes.hpp"
+#include "trace/traceRecorder.hpp"
 #include "caesar.hpp"
 
 namespace SherpadCaesar{
@@ -13,7 +29,7 @@ namespace SherpadCaesar{
 /// @param d Data used to manage what needs to be performed.
 ///==============================================================================
 Caesar_t::Caesar_t(Data_t& d)
-    : m_inputData { d } {
+    : m_inputData { d }, m_output { nullptr }, m_stats { } {
 
 }
 
@@ -37,10 +53,83 @@ Caesar_t::ask(){
 void
 Caesar_t::performTransformation(){
 
-    if (m_inputData.isBulk())
-       bulkEncryptionOrDecryption(m_inputData.getData());
-    else
-       encryptionOrDecryption(m_inputData.getData(), m_inputData.getLevel());
+    using Clock_t= std::chrono::steady_clock;
+
+    //The questions and messages written before must go out before the result.
+    std::cout.flush();
+
+    //Without --trace no recorder is started, and the spans of the run record nothing.
+    std::unique_ptr<TraceRecorder_t> trace { m_inputData.isTrace() ? std::make_unique<TraceRecorder_t>(m_inputData.getTracePath()) : nullptr };
+
+    if (trace != nullptr)
+       trace->start();
+
+    CAESAR_PROBE2(job_start, static_cast<int>(m_inputData.getDirection()), m_inputData.getLevel());
+
+    //The clock and the allocation counter are always read: it costs nothing next to the transformation.
+    const Clock_t::time_point start              { Clock_t::now() };
+    const std::size_t         allocations        { getAllocationCount() };
+          std::size_t         loadingAllocations { 0 };
+
+    if (m_inputData.isIndexBuild())
+       buildIndex();
+    else if (m_inputData.isCrib() || m_inputData.isIndexSearch())
+       cribEncryptionOrDecryption();
+    else if (m_inputData.isCrack())
+       crackEncryptionOrDecryption();
+    else if (m_inputData.isMirror())
+       mirrorEncryptionOrDecryption();
+    else if (m_inputData.isBatch())
+       batchEncryptionOrDecryption();
+    else if (m_inputData.isInPlace())
+       inPlaceEncryptionOrDecryption();
+    else{
+       //Truncating the output file would destroy the input before it is read.
+       if (isOutputTheInput())
+          throw CaesarException_t(EXCEPTION_10);
+
+       if (m_inputData.isStreaming()){
+          openOutput();
+          streamEncryptionOrDecryption();
+       }
+       else{
+          const Clock_t::time_point loadingStart { Clock_t::now() };
+
+          {
+             TraceSpan_t span { "load", "io" };
+
+             m_inputData.loadData();
+             span.setArgument("bytes", static_cast<long long>(m_inputData.getData().size()));
+          }
+
+          m_stats.addTime(loadingPhase, std::chrono::duration<double>(Clock_t::now() - loadingStart).count());
+          loadingAllocations= getAllocationCount() - allocations;
+
+          if (m_inputData.isBulk() || m_inputData.isMultiLevel()){
+             openOutput();
+             bulkEncryptionOrDecryption(m_inputData.getData(), m_inputData.getLevels());
+          }
+          else
+             encryptionOrDecryption(m_inputData.getData(), m_inputData.getLevel());
+       }
+    }
+
+    if (m_output != nullptr)
+       m_output->flush();
+
+    //The writes happen in the middle of the transformation: their time is taken apart.
+    const double outputTime { m_output != nullptr ? m_output->getWriteTime() : 0.0 };
+
+    m_stats.addTime(outputPhase, outputTime);
+    m_stats.addTime(transformPhase, std::chrono::duration<double>(Clock_t::now() - start).count() - m_stats.getTime(loadingPhase) - outputTime);
+    m_stats.addAllocations(getAllocationCount() - allocations - loadingAllocations);
+
+    CAESAR_PROBE2(job_end, m_inputData.getLevel(), m_output != nullptr ? m_output->getBytesWritten() : std::size_t { 0 });
+
+    if (trace != nullptr){
+       trace->stop();
+       trace->write();
+    }
 }
 
 ///==============================================================================
@@ -53,6 +142,11 @@ Caesar_t::validateInputParameters(){
     if (!m_inputData.needDisplayHelp()     && !m_inputData.needDisplayInformation() &&
         !m_inputData.needDisplayWarranty() && !m_inputData.needDisplayConditions()){
 
+       //Cracking and searching a crib are always a decryption, and an index doesn't depend on the direction.
+       if ((m_inputData.isCrack() || m_inputData.isCrib() || m_inputData.isIndexBuild() || m_inputData.isIndexSearch()) &&
+           !m_inputData.wantEncrypt() && !m_inputData.wantDecrypt())
+          m_inputData.setFlagDecrypt(true);
+
        if (!m_inputData.wantEncrypt() && !m_inputData.wantDecrypt()){
           m_inputData.initEncryptOrDecrypt();
           askEncryptOrDecrypt();
@@ -63,12 +157,16 @@ Caesar_t::validateInputParameters(){
           askLanguage();
        }
 
-       if (!m_inputData.isFromFile() && !m_inputData.isFromString()){
+       //The files of a batch or an index come after its flag, and those of a mirror from its directory: there is nothing to ask.
+       if (!m_inputData.isFromFile() && !m_inputData.isFromString() && !m_inputData.isBatch() && !m_inputData.isMirror() &&
+           !m_inputData.isIndexBuild() && !m_inputData.isIndexSearch()){
           m_inputData.initFileOrString();
           askFileOrString();
        }
 
-       if (!m_inputData.isSpecific() && !m_inputData.isBulk()){
+       //The levels of --crack and --crib are found from the input, and an index has every level.
+       if (!m_inputData.isSpecific() && !m_inputData.isMultiLevel() && !m_inputData.isBulk() && !m_inputData.isCrack() && !m_inputData.isCrib() &&
+           !m_inputData.isIndexBuild()){
           m_inputData.initLevel();
           askForSpecificLevel();
        }
@@ -89,8 +187,15 @@ Caesar_t::process(){
        writeWarranty();
     else if (m_inputData.needDisplayConditions())
        writeConditions();
-    else
+    else{
        performTransformation();
+
+       if (m_inputData.isStats())
+          writeStats();
+
+       if (m_inputData.isPerf())
+          writePerf();
+    }
 }
 
 ///==============================================================================
@@ -111,10 +216,48 @@ Caesar_t::writeHelp() const noexcept{
     std::cout << "[+]         -e: Encrypt the message. \n";
     std::cout << "[+]         -d: Decrypt the message. \n";
     std::cout << "[+]         -s: Encrypt or decrypt a text string. \n";
-    std::cout << "[+]         -f: Encrypt or decrypt data from text file. \n";
+    std::cout << "[+]         -f: Encrypt or decrypt data from text file. If the file is -, the standard input is read. \n";
+    std::cout << "[+]             A pipe or a device, such as /dev/stdin or <(command), is read too. \n";
+    std::cout << "[+]             At a specific level it is read in blocks and written as it goes. \n";
     std::cout << "[+]         -k: Choose the language. English language (en) or Spanish language (sp). The default language is English. \n";
     std::cout << "[+]         -l: Level of encryption or decryption you want to use specifically. \n";
+    std::cout << "[+]             It can also be a list of levels and ranges, like 3-7,12. \n";
     std::cout << "[+]             If there isn't level, it performs bulk encryption or decryption. \n";
+    std::cout << "[+]         -o: Writes the result in a file instead of the standard output. \n";
+    std::cout << "[+] \n";
+    std::cout << "[+]    - The long flags are: \n";
+    std::cout << "[+]         --isa: Instruction set used with the English alphabet: scalar, sse2, avx2 or avx512. \n";
+    std::cout << "[+]                By default the widest one supported by the processor is used. \n";
+    std::cout << "[+]         --threads: Number of threads that share out the levels of a bulk transformation or a list of levels, \n";
+    std::cout << "[+]                    or the chunks of a big text transformed at a specific level or at every level. \n";
+    std::cout << "[+]                    By default one per hardware thread is used. \n";
+    std::cout << "[+]         --stream: Reads the file in blocks instead of loading it whole, so the memory used doesn't depend on its size. \n";
+    std::cout << "[+]                   A bulk transformation or a list of levels reads the file once per level. \n";
+    std::cout << "[+]         --buffer-size: Size of the blocks of --stream, in bytes or with the suffix K or M (4K to 1024M). The default is 1M. \n";
+    std::cout << "[+]         --in-place: Rewrites the file of -f with the result, at a specific level. The size of the file can't change. \n";
+    std::cout << "[+]         --batch: Directory where many files are written at a specific level, each one with its own name. \n";
+    std::cout << "[+]                  The files are the arguments after it that aren't values of a flag. \n";
+    std::cout << "[+]         --list: File with more files for --batch, one path per line. \n";
+    std::cout << "[+]         --mirror: Source directory whose whole tree is written in the directory of --batch, at a specific level. \n";
+    std::cout << "[+]                   A manifest in that directory remembers the files already transformed, so the next runs \n";
+    std::cout << "[+]                   only transform the new and changed files and remove the outputs of the deleted ones. \n";
+    std::cout << "[+]         --crack: Decrypts only at the levels that most likely decrypt the input, found from the frequencies of its letters. \n";
+    std::cout << "[+]                  The language is found as well, unless it is selected with -k. The ranking is written to the standard error. \n";
+    std::cout << "[+]         --top: Number of levels written by --crack, from the most likely one. The default is 1. \n";
+    std::cout << "[+]         --sample: Size of the start of the input analyzed by --crack, in bytes or with the suffix K or M (1K to 1024M). \n";
+    std::cout << "[+]                   With a single level, the rest of the input is decrypted as it is read. By default the whole input is analyzed. \n";
+    std::cout << "[+]         --crib: Known piece of the plaintext. Writes the levels that decrypt it somewhere in the input, and where, \n";
+    std::cout << "[+]                 reading the input once and without decrypting it. The letters match regardless of their case. \n";
+    std::cout << "[+]         --build-index: Path of an index of the files written after it, or listed with --list, to search cribs in them \n";
+    std::cout << "[+]                        later. The index is built in the alphabet of the language (-k) and is valid for every level. \n";
+    std::cout << "[+]         --index: Path of an index where the crib is searched: only the files that can contain it are read. \n";
+    std::cout << "[+]         --stats: Writes a summary of the run to the standard error: time of every phase, bytes read and written, \n";
+    std::cout << "[+]                  throughput, characters by class, peak memory and heap allocations while transforming. \n";
+    std::cout << "[+]         --perf: Writes the hardware counters (cycles, instructions, branch misses, L1 and LLC misses) of every \n";
+    std::cout << "[+]                 stage of the transformation of the input to the standard error: decode, lookup and shift of the \n";
+    std::cout << "[+]                 path of a character at a time, the engine that replaced them, and the output. \n";
+    std::cout << "[+]         --trace: Path of a timeline of the run in trace-event JSON, for chrome://tracing or Perfetto, with a span \n";
+    std::cout << "[+]                  per chunk or block read, transformed and written, and per level of a bulk transformation. \n";
     std::cout << "[+] \n";
     std::cout << "[+] Examples with inputs parameter: \n";
     std::cout << "[+]      caesar -e -s word \n";
@@ -155,8 +298,19 @@ Caesar_t::writeHelp() const noexcept{
     std::cout << "[+]      caesar -ekfl sp " << std::quoted("my file.txt") << " 5 \n";
     std::cout << "[+]      caesar -d -f file.txt \n";
     std::cout << "[+]      caesar -df file.txt \n";
+    std::cout << "[+]      caesar -d -f file.txt -l 3-7,12 \n";
     std::cout << "[+]      caesar -d -f file.txt -l 5 \n";
     std::cout << "[+]      caesar -dfl file.txt 5 \n";
+    std::cout << "[+]      caesar -d -f file.txt -l 5 -o result.txt \n";
+    std::cout << "[+]      caesar -d -f file.txt -l 5 --in-place \n";
+    std::cout << "[+]      caesar -d -f file.txt --crack --top=3 \n";
+    std::cout << "[+]      caesar -d -f file.txt --crack --sample=64K -o result.txt \n";
+    std::cout << "[+]      caesar -d -f file.txt --crib=\"Dear Sir\" \n";
+    std::cout << "[+]      caesar -k en --build-index=archive.idx file1.txt file2.txt --list=files.txt \n";
+    std::cout << "[+]      caesar --index=archive.idx --crib=\"Dear Sir\" \n";
+    std::cout << "[+]      zcat file.txt.gz | caesar -d -f - -l 5 | gzip > result.txt.gz \n";
+    std::cout << "[+]      caesar -d -l 5 --batch results first.txt second.txt --list=more.txt \n";
+    std::cout << "[+]      caesar -e -l 5 --mirror documents --batch encrypted \n";
     std::cout << "[+]      caesar -d -k sp -f file.txt -l 5 \n";
     std::cout << "[+]      caesar -dkfl sp file.txt 5 \n";
     std::cout << "[+]      caesar -d -f " << std::quoted("my file.txt") << " \n";
@@ -306,7 +460,7 @@ Caesar_t::askPathOrStringValue(const bool isFile){
     do{
        if (isFile){
           m_inputData.pushNextParameter(CHARACTER_f);
-          std::cout << "[+] Write the path (including regular file): \n";
+          std::cout << "[+] Write the path (including regular file, pipe or device): \n";
        }
        else{
           m_inputData.pushNextParameter(CHARACTER_s);
@@ -414,19 +568,36 @@ Caesar_t::askLevel(){
 }
 
 ///==============================================================================
-/// @brief Manages bulk encryption or decryption.
+/// @brief Manages bulk encryption or decryption. The data is read once for all
+///        the levels, which are shared out between the threads and written in
+///        order.
 /// @param data Data to be transformed.
+/// @param levels Levels to perform the transformation, in order.
 ///==============================================================================
 void 
-Caesar_t::bulkEncryptionOrDecryption(const std::string& data) const noexcept{
+Caesar_t::bulkEncryptionOrDecryption(const std::string_view data, const std::vector<int>& levels){
+
+    const BulkTransformer_t transformer { m_inputData.getLanguage(), m_inputData.getDirection(), levels, m_inputData.getIsa(), m_inputData.getThreads() };
+    //Bytes of the level being written, for the bulk_level probe.
+          std::size_t       levelBytes  { 0 };
+    const LevelOutput_t     output      {
+       [this, &levelBytes](const int currentLevel){
+          CAESAR_PROBE1(bulk_level_start, currentLevel);
+          levelBytes= 0;
+          writeLevelHeader(currentLevel);
+       },
+       [this, &levelBytes](const char* text, const std::size_t size){
+          levelBytes+= size;
+          m_output->write(text, size);
+       },
+       [this, &levelBytes](const int currentLevel){
+          m_output->write("\n");
+          writeLevelFooter();
+          CAESAR_PROBE2(bulk_level, currentLevel, levelBytes);
+       }
+    };
 
-    for (int currentLevel= m_inputData.getMinLevel(); currentLevel <= m_inputData.getMaxLevel(); currentLevel++){
-       std::cout << "[+]--- Level: " << currentLevel << " ---\n";
-       std::cout << "[+] \n";
-       encryptionOrDecryption(data, currentLevel);
-       std::cout << "[+]----------------------------------------------------------------------\n";
-       std::cout << "[+] \n";
-    }
+    transformer.run(data, output);
 }
 
 ///==============================================================================
@@ -435,50 +606,677 @@ Caesar_t::bulkEncryptionOrDecryption(const std::string& data) const noexcept{
 /// @param currentLevel Current level to perform the transformation.
 ///==============================================================================
 void
-Caesar_t::encryptionOrDecryption(const std::string& data, const int currentLevel) const noexcept{
+Caesar_t::encryptionOrDecryption(const std::string_view data, const int currentLevel){
 
-    if (m_inputData.wantEncrypt())
-       transform(data, currentLevel);
-    else
-       transform(data, currentLevel*(-1));
-    
+    //The language and the direction are resolved here once, not per character.
+    const Engine_t engine { m_inputData.getLanguage(), m_inputData.getDirection(), currentLevel, m_inputData.getIsa(), m_inputData.getThreads() };
+
+    if (m_inputData.hasOutputFile() && engine.isLengthPreserving() && isOutputMappable())
+       mapEncryptionOrDecryption(data, engine);
+    else{
+       openOutput();
+       transform(data, engine);
+    }
 }
 
 ///==============================================================================
 /// @brief Manages encryption or decryption.
 /// @param data Data to be transformed.
-/// @param currentLevel Current level to perform the transformation.
+/// @param engine Engine of the language, level and direction.
+///==============================================================================
+void
+Caesar_t::transform(const std::string_view data, const Engine_t& engine){
+
+    engine.run(data, [this](const char* text, const std::size_t size){ m_output->write(text, size); });
+
+    m_output->write("\n");
+}
+
+///==============================================================================
+/// @brief Manages encryption or decryption into an output file of the same
+///        size as the data. The file is preallocated and mapped, and the data
+///        is transformed straight into it, without write(2) or a buffer.
+/// @param data Data to be transformed.
+/// @param engine Engine of the language, level and direction. It must keep
+///        the size of the data.
+///==============================================================================
+void
+Caesar_t::mapEncryptionOrDecryption(const std::string_view data, const Engine_t& engine) const{
+
+    //The last byte is the line break that ends the output, like in the standard output.
+    SharedMapping_t output { m_inputData.getOutputPath(), data.length() + 1 };
+
+    engine.runInto(data, output.getData());
+
+    output.getData()[data.length()]= '\n';
+}
+
+///==============================================================================
+/// @brief Manages encryption or decryption of a file rewritten in place
+///        through a shared mapping, without a copy of it. Nothing is added to
+///        the file, not even the final line break of the standard output.
+///==============================================================================
+void
+Caesar_t::inPlaceEncryptionOrDecryption() const{
+
+    if (!m_inputData.isFromFile() || m_inputData.isReadOnce() || !m_inputData.isSpecific() || m_inputData.hasOutputFile())
+       throw CaesarException_t(EXCEPTION_11);
+
+    const Engine_t        engine { m_inputData.getLanguage(), m_inputData.getDirection(), m_inputData.getLevel(), m_inputData.getIsa(), m_inputData.getThreads() };
+          SharedMapping_t file   { m_inputData.getPath() };
+
+    if (engine.isLengthPreserving())
+       engine.runInto(std::string_view { file.getData(), file.getSize() }, file.getData());
+    else
+       rewriteInPlace(file.getData(), file.getSize(), engine);
+}
+
+///==============================================================================
+/// @brief Manages encryption or decryption of many files at once, each one into
+///        a file with the same name in the directory of the batch. The files
+///        that fail are reported and the rest of the batch goes on.
 ///==============================================================================
 void
-Caesar_t::transform(const std::string& data, const int currentLevel) const noexcept{
+Caesar_t::batchEncryptionOrDecryption() const{
+
+    const std::vector<std::string>& paths { m_inputData.getBatchPaths() };
+
+    if (m_inputData.getBatchDirectory().empty() || paths.empty() || !m_inputData.isSpecific() ||
+        m_inputData.isFromString() || m_inputData.isFromFile() || m_inputData.hasOutputFile() || m_inputData.isInPlace())
+       throw CaesarException_t(EXCEPTION_13);
+
+    const Engine_t           engine { m_inputData.getLanguage(), m_inputData.getDirection(), m_inputData.getLevel(), m_inputData.getIsa() };
+    const BatchTransformer_t batch  { engine.getTransformer(), m_inputData.getThreads() };
+          std::size_t        failed { 0 };
+
+    for (const BatchResult_t& result : batch.run(paths, m_inputData.getBatchDirectory())){
+       if (!result.error.empty()){
+          failed++;
+          std::cerr << "[-] " << result.path << ": " << result.error << " \n";
+       }
+    }
 
-    size_t index { 0 };
+    std::cout << "[+] " << paths.size() - failed << " of " << paths.size() << " files transformed into " << m_inputData.getBatchDirectory() << ". \n";
+    std::cout << "[+] \n";
+}
 
-    while (index < data.length()){
+///==============================================================================
+/// @brief Manages encryption or decryption of a whole directory tree into the
+///        directory of the batch. Only the files that are new or changed since
+///        the last run are transformed.
+///==============================================================================
+void
+Caesar_t::mirrorEncryptionOrDecryption() const{
+
+    const std::string& source { m_inputData.getMirrorDirectory() };
+    const std::string& target { m_inputData.getBatchDirectory() };
+    std::error_code    eCode;
 
-                      int length { m_inputData.getUTF8CharLength(static_cast<unsigned char>(data[index])) };
-              std::string c      { data.substr(index, length) };
-          DataCharacter_t dC     { };
+    if (source.empty() || target.empty() || !m_inputData.getBatchPaths().empty() || !m_inputData.isSpecific() ||
+        m_inputData.isFromString() || m_inputData.isFromFile() || m_inputData.hasOutputFile() || m_inputData.isInPlace() ||
+        std::filesystem::equivalent(source, target, eCode))
+       throw CaesarException_t(EXCEPTION_15);
 
-          m_inputData.findCharacterData(c, dC);
+    //A manifest written with other parameters describes outputs that aren't valid anymore.
+    const std::string       parameters  { std::string { m_inputData.isSpanishLanguage() ? SPANISH_LANGUAGE : ENGLISH_LANGUAGE } +
+                                          (m_inputData.wantDecrypt() ? " -d" : " -e") + " -l " + std::to_string(m_inputData.getLevel()) };
+    const Engine_t          engine      { m_inputData.getLanguage(), m_inputData.getDirection(), m_inputData.getLevel(), m_inputData.getIsa() };
+    const DirectoryMirror_t mirror      { engine.getTransformer(), parameters, m_inputData.getThreads() };
+    const MirrorResult_t    result      { mirror.run(source, target) };
 
-          switch (dC.type){
-             case capitalLetter:
-                std::cout << m_inputData.getTransformedCharacter(m_inputData.getAlphabetUppercase(), dC.position, currentLevel);
+    for (const BatchResult_t& failed : result.failed)
+       std::cerr << "[-] " << failed.path << ": " << failed.error << " \n";
 
-                break;
-             case smallLetter:
-                std::cout << m_inputData.getTransformedCharacter(m_inputData.getAlphabetLowercase(), dC.position, currentLevel);
+    std::cout << "[+] " << result.transformed << " files transformed, " << result.unchanged << " unchanged, " << result.removed << " removed and "
+              << result.failed.size() << " failed in " << target << ". \n";
+    std::cout << "[+] \n";
+}
 
-                break;
-             default:
-                std::cout << c;
+///==============================================================================
+/// @brief Manages the decryption at the levels that most likely decrypt the
+///        input, instead of all of them. The input, or its start with
+///        --sample, is read once to count its letters, and the levels are
+///        ranked from those counts. With a single level and a sample, the rest
+///        of the input is decrypted as it is read.
+///==============================================================================
+void
+Caesar_t::crackEncryptionOrDecryption(){
+
+    if (m_inputData.wantEncrypt() || !m_inputData.isBulk() || (!m_inputData.isFromFile() && !m_inputData.isFromString()) ||
+        m_inputData.isInPlace() || m_inputData.isBatch() || m_inputData.isMirror())
+       throw CaesarException_t(EXCEPTION_18);
+
+    //Truncating the output file would destroy the input before it is read.
+    if (isOutputTheInput())
+       throw CaesarException_t(EXCEPTION_10);
+
+    FrequencyAnalyzer_t analyzer { };
+
+    if (m_inputData.isFromFile() && m_inputData.getSampleSize() > 0){
+       BlockReader_t    reader { m_inputData.getPath(), m_inputData.getBufferSize() };
+       std::string      sample { };
+       std::string_view block  { };
+
+       while (sample.length() < m_inputData.getSampleSize() && reader.next(block))
+          sample.append(block);
+
+       //The blocks read go past the sample, but only the sample is analysed; the rest is still output.
+       const std::size_t sampleLength { sample.length() > m_inputData.getSampleSize() ?
+                                        findUTF8Boundary(sample.data(), sample.length(), m_inputData.getSampleSize()) : sample.length() };
+
+       analyzer.add(std::string_view { sample }.substr(0, sampleLength));
+
+       const std::vector<int> levels { rankLevels(analyzer) };
+
+       openOutput();
+
+       if (levels.size() == 1){
+          const Engine_t          engine { m_inputData.getLanguage(), m_inputData.getDirection(), levels.front(), m_inputData.getIsa(), m_inputData.getThreads() };
+                std::vector<char> output ( engine.getMaxOutputLength(m_inputData.getBufferSize()) );
+
+          engine.run(sample, [this](const char* text, const std::size_t size){ m_output->write(text, size); });
+
+          while (reader.next(block)){
+             m_output->write(output.data(), engine.transform(block, output.data()));
+
+             if (m_inputData.isReadOnce())
+                m_output->flush();
           }
-          
-          index+= length;
+
+          m_output->write("\n");
+       }
+       //Every level needs the whole input: the standard input or a pipe is read to the end, a file is mapped.
+       else if (m_inputData.isReadOnce()){
+          while (reader.next(block))
+             sample.append(block);
+
+          bulkEncryptionOrDecryption(sample, levels);
+       }
+       else{
+          m_inputData.loadData();
+          bulkEncryptionOrDecryption(m_inputData.getData(), levels);
+       }
     }
-    
-    std::cout << '\n';
+    else{
+       m_inputData.loadData();
+       analyzer.add(m_inputData.getData());
+
+       const std::vector<int> levels { rankLevels(analyzer) };
+
+       if (levels.size() == 1)
+          encryptionOrDecryption(m_inputData.getData(), levels.front());
+       else{
+          openOutput();
+          bulkEncryptionOrDecryption(m_inputData.getData(), levels);
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Ranks the levels of decryption from the letters counted. The
+///        language of the best level becomes the language of the input, unless
+///        it was selected with -k. The ranking is written to the standard
+///        error, so the standard output only has the decrypted text.
+/// @param analyzer Letters of the input.
+/// @return The best levels of the language, from the best one.
+///==============================================================================
+std::vector<int>
+Caesar_t::rankLevels(const FrequencyAnalyzer_t& analyzer){
+
+    std::vector<Language_t>       languages  { m_inputData.getLanguage() };
+    std::vector<CrackCandidate_t> candidates { };
+    std::vector<int>              levels     { };
+
+    if (!m_inputData.isLanguageSelected())
+       languages= { englishLanguage, spanishLanguage };
+
+    candidates= analyzer.rank(languages);
+
+    if (candidates.empty())
+       throw CaesarException_t(EXCEPTION_19);
+
+    const Language_t language { candidates.front().language };
+
+    m_inputData.setLanguage(language);
+
+    std::cerr << "[+] Language: " << (language == spanishLanguage ? "Spanish" : "English") << ". Most likely levels, by the chi-squared of their letters (lower is better): \n";
+
+    for (const CrackCandidate_t& candidate : candidates){
+       if (candidate.language != language)
+          continue;
+
+       levels.push_back(candidate.level);
+       std::cerr << "[+]    Level " << candidate.level << ": " << std::fixed << std::setprecision(2) << candidate.score << " \n";
+
+       if (levels.size() == static_cast<std::size_t>(m_inputData.getTop()))
+          break;
+    }
+
+    std::cerr << "[+] \n";
+
+    return levels;
+}
+
+///==============================================================================
+/// @brief Finds the levels that decrypt a known piece of the plaintext, the
+///        crib, somewhere in the input. The input is read once and searched
+///        for the crib at every level of every language at the same time,
+///        without decrypting it. With an index, only the files of the index
+///        that can contain the crib are searched.
+///==============================================================================
+void
+Caesar_t::cribEncryptionOrDecryption() const{
+
+    //The files of an index replace the file or the string.
+    if (!m_inputData.isCrib() || m_inputData.wantEncrypt() || !m_inputData.isBulk() || m_inputData.isIndexSearch() == (m_inputData.isFromFile() || m_inputData.isFromString()) ||
+        m_inputData.hasOutputFile() || m_inputData.isCrack() || m_inputData.isInPlace() || m_inputData.isBatch() || m_inputData.isMirror())
+       throw CaesarException_t(EXCEPTION_20);
+
+    if (m_inputData.isIndexSearch()){
+       const CribIndex_t              index      { m_inputData.getIndexPath() };
+       const std::vector<Language_t>  languages  { index.getLanguage() };
+             std::size_t              found      { 0 };
+
+       if (!CribSearcher_t { index.getLanguage(), m_inputData.getCrib() }.isValid())
+          throw CaesarException_t(EXCEPTION_21);
+
+       const std::vector<std::string> candidates { index.findCandidates(m_inputData.getCrib()) };
+
+       for (const std::string& path : candidates){
+          //The file may have changed since it was indexed: the open or the read that fails tells why.
+          errno= 0;
+
+          try{
+             if (writeCribMatches(languages, path, path + ": "))
+                found++;
+          }
+          catch (const std::exception&){
+             std::cerr << "[-] " << path << ": " << (errno != 0 ? std::strerror(errno) : "Error reading the file.") << " \n";
+          }
+       }
+
+       std::cout << "[+] The crib was found in " << found << " of the " << candidates.size() << " files that can contain it, out of " << index.getNumFiles() << " indexed. \n";
+       std::cout << "[+] \n";
+       return;
+    }
+
+    std::vector<Language_t> languages { };
+
+    //The crib must have two letters in the alphabet of a language to search its levels.
+    for (const Language_t language : { englishLanguage, spanishLanguage })
+       if ((!m_inputData.isLanguageSelected() || language == m_inputData.getLanguage()) && CribSearcher_t { language, m_inputData.getCrib() }.isValid())
+          languages.push_back(language);
+
+    if (languages.empty())
+       throw CaesarException_t(EXCEPTION_21);
+
+    if (!writeCribMatches(languages, m_inputData.isFromFile() ? m_inputData.getPath() : STRING_EMPTY, ""))
+       std::cout << "[+] The crib wasn't found at any level. \n";
+
+    std::cout << "[+] \n";
+}
+
+///==============================================================================
+/// @brief Searches the crib in a file or in the string of the input, and
+///        writes the levels that decrypt it with the positions of their first
+///        matches.
+/// @param languages Languages whose levels are searched. The crib must be
+///        valid in all of them.
+/// @param path Path of the file. If it is empty, the string is searched.
+/// @param prefix Text written before every level, such as the path.
+/// @return true whether the crib was found at some level.
+///==============================================================================
+bool
+Caesar_t::writeCribMatches(const std::vector<Language_t>& languages, const std::string_view path, const std::string_view prefix) const{
+
+    constexpr std::size_t MAX_OFFSETS { 10 };
+
+    using Counts_t = std::vector<std::uint64_t>;
+    using Offsets_t= std::vector<std::vector<std::uint64_t>>;
+
+    std::vector<CribSearcher_t> searchers { };
+    std::vector<CribMatch_t>    matches   { };
+    //Matches of every level of every language, and the positions of the first ones.
+    std::vector<Counts_t>       counts    ( languages.size(), Counts_t (MAX_LEVEL_SPANISH + 1, 0) );
+    std::vector<Offsets_t>      offsets   ( languages.size(), Offsets_t(MAX_LEVEL_SPANISH + 1) );
+    bool                        isFound   { false };
+
+    for (const Language_t language : languages)
+       searchers.emplace_back(language, m_inputData.getCrib());
+
+//==============================================================================
+//                         LAMBDA search
+//==============================================================================
+    auto search= [&](const std::string_view text){
+        for (std::size_t i= 0; i < searchers.size(); i++){
+           matches.clear();
+           searchers[i].add(text, matches);
+
+           for (const CribMatch_t& match : matches){
+              if (counts[i][match.level]++ < MAX_OFFSETS)
+                 offsets[i][match.level].push_back(match.offset);
+           }
+        }
+    };
+
+    if (!path.empty()){
+       BlockReader_t    reader { path, m_inputData.getBufferSize() };
+       std::string_view block  { };
+
+       while (reader.next(block))
+          search(block);
+    }
+    else
+       search(m_inputData.getData());
+
+    for (std::size_t i= 0; i < searchers.size(); i++){
+       for (int level= MIN_LEVEL; level <= MAX_LEVEL_SPANISH; level++){
+          if (counts[i][level] == 0)
+             continue;
+
+          isFound= true;
+          std::cout << "[+] " << prefix << "Level " << level << " in " << (languages[i] == spanishLanguage ? "Spanish" : "English") << ": " << counts[i][level]
+                    << (counts[i][level] == 1 ? " match at byte " : " matches at bytes ");
+
+          for (std::size_t j= 0; j < offsets[i][level].size(); j++)
+             std::cout << (j > 0 ? ", " : "") << offsets[i][level][j];
+
+          if (counts[i][level] > offsets[i][level].size())
+             std::cout << " and " << counts[i][level] - offsets[i][level].size() << " more";
+
+          std::cout << ". \n";
+       }
+    }
+
+    return isFound;
+}
+
+///==============================================================================
+/// @brief Builds an index of the files given after --build-index, so cribs can
+///        be searched later only in the files that can contain them. The
+///        fingerprints use the alphabet of the language selected.
+///==============================================================================
+void
+Caesar_t::buildIndex() const{
+
+    const std::vector<std::string>& paths { m_inputData.getBatchPaths() };
+
+    if (m_inputData.getIndexPath().empty() || paths.empty() || !m_inputData.isBulk() || m_inputData.isFromString() || m_inputData.isFromFile() ||
+        m_inputData.hasOutputFile() || m_inputData.isInPlace() || m_inputData.isBatch() || m_inputData.isMirror() || m_inputData.isCrack() ||
+        m_inputData.isCrib() || m_inputData.isIndexSearch())
+       throw CaesarException_t(EXCEPTION_22);
+
+    const IndexResult_t result { CribIndex_t::build(m_inputData.getLanguage(), paths, m_inputData.getIndexPath(), m_inputData.getThreads()) };
+
+    for (const BatchResult_t& failed : result.failed)
+       std::cerr << "[-] " << failed.path << ": " << failed.error << " \n";
+
+    std::cout << "[+] " << result.indexed << " of " << paths.size() << " files indexed in " << m_inputData.getIndexPath() << ". \n";
+    std::cout << "[+] \n";
+}
+
+///==============================================================================
+/// @brief Rewrites a text in place with a transformation that can change the
+///        size of some characters. A first pass checks that the size of the
+///        whole text doesn't change; the second one transforms it block by
+///        block and only writes over the bytes that have already been read.
+/// @param text Text to rewrite.
+/// @param size Size of the text in bytes.
+/// @param engine Engine of the language, level and direction.
+///==============================================================================
+void
+Caesar_t::rewriteInPlace(char* text, const std::size_t size, const Engine_t& engine) const{
+
+    const std::size_t       blockSize { m_inputData.getBufferSize() };
+          std::vector<char> output    ( engine.getMaxOutputLength(blockSize) );
+          std::vector<char> pending   { };
+          std::size_t       total     { 0 };
+          std::size_t       out       { 0 };
+
+//==============================================================================
+//                         LAMBDA getBlockLength
+//==============================================================================
+    auto getBlockLength= [&](const std::size_t in){
+        //A character cut at the end of a block is left for the next one.
+        return (size - in <= blockSize) ? size - in : getCompleteUTF8Length(text + in, blockSize);
+    };
+
+    for (std::size_t in= 0, length= 0; in < size; in+= length){
+       length= getBlockLength(in);
+       total+= engine.transform(std::string_view { text + in, length }, output.data());
+    }
+
+    if (total != size)
+       throw CaesarException_t(EXCEPTION_12);
+
+    for (std::size_t in= 0, length= 0; in < size; in+= length){
+       length= getBlockLength(in);
+
+       const std::size_t written { engine.transform(std::string_view { text + in, length }, output.data()) };
+       const std::size_t ready   { std::min(pending.size() + written, in + length - out) };
+
+       pending.insert(pending.end(), output.data(), output.data() + written);
+
+       std::memcpy(text + out, pending.data(), ready);
+       pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(ready));
+       out+= ready;
+    }
+}
+
+///==============================================================================
+/// @brief Opens where the result is written: the output file or, if there
+///        isn't one, the standard output.
+///==============================================================================
+void
+Caesar_t::openOutput(){
+
+    if (m_inputData.hasOutputFile())
+       m_output= std::make_unique<OutputSink_t>(m_inputData.getOutputPath());
+    else
+       m_output= std::make_unique<OutputSink_t>(STDOUT_FILENO);
+}
+
+///==============================================================================
+/// @brief Indicates whether the output file is the input file, even through
+///        another path or a link.
+/// @return true whether both paths are the same file.
+///==============================================================================
+bool
+Caesar_t::isOutputTheInput() const noexcept{
+
+    std::error_code eCode;
+
+    return m_inputData.hasOutputFile() && m_inputData.isFromFile() && !m_inputData.isReadOnce() && std::filesystem::equivalent(m_inputData.getPath(), m_inputData.getOutputPath(), eCode);
+}
+
+///==============================================================================
+/// @brief Indicates whether the output file can be mapped: it is a regular
+///        file or it doesn't exist yet. A device or a pipe, such as
+///        /dev/stdout, can't be truncated or mapped, so it is written.
+/// @return true whether the output can be mapped.
+///==============================================================================
+bool
+Caesar_t::isOutputMappable() const noexcept{
+
+    std::error_code                    eCode;
+    const std::filesystem::file_status status { std::filesystem::status(m_inputData.getOutputPath(), eCode) };
+
+    return status.type() == std::filesystem::file_type::regular || status.type() == std::filesystem::file_type::not_found;
+}
+
+///==============================================================================
+/// @brief Manages encryption or decryption of a file read in blocks, so the
+///        memory used doesn't depend on its size. A bulk transformation or a
+///        list of levels reads the file again for every level.
+///==============================================================================
+void
+Caesar_t::streamEncryptionOrDecryption(){
+
+    if (m_inputData.isSpecific()){
+       streamLevel(m_inputData.getLevel());
+       m_output->write("\n");
+    }
+    else{
+       const std::vector<int> levels { m_inputData.getLevels() };
+
+       //The file is read again for every level, but it is only one input.
+       for (std::size_t i= 0; i < levels.size(); i++){
+          writeLevelHeader(levels[i]);
+          streamLevel(levels[i], i == 0);
+          m_output->write("\n");
+          writeLevelFooter();
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Transforms the file block by block at a level and writes it.
+/// @param currentLevel Current level to perform the transformation.
+/// @param countInput Indicates whether the bytes read are added to the stats.
+///==============================================================================
+void
+Caesar_t::streamLevel(const int currentLevel, const bool countInput){
+
+    const Engine_t          engine { m_inputData.getLanguage(), m_inputData.getDirection(), currentLevel, m_inputData.getIsa(), m_inputData.getThreads() };
+          BlockReader_t     reader { m_inputData.getPath(), m_inputData.getBufferSize() };
+          std::vector<char> output ( engine.getMaxOutputLength(m_inputData.getBufferSize()) );
+          std::string_view  block  { };
+
+//==============================================================================
+//                         LAMBDA readBlock
+//==============================================================================
+    auto readBlock= [&reader, &block](){
+        TraceSpan_t span   { "read", "block" };
+        const bool  isRead { reader.next(block) };
+
+        span.setArgument("bytes", static_cast<long long>(block.size()));
+
+        return isRead;
+    };
+
+    while (readBlock()){
+       std::size_t size { 0 };
+
+       if (countInput)
+          m_stats.addBytesIn(block.size());
+
+       {
+          TraceSpan_t span { "transform", "block" };
+
+          span.setArgument("bytes", static_cast<long long>(block.size()));
+          size= engine.transform(block, output.data());
+       }
+
+       TraceSpan_t span { "write", "block" };
+
+       span.setArgument("bytes", static_cast<long long>(size));
+       m_output->write(output.data(), size);
+
+       //In the middle of a pipeline every block goes on as soon as it is transformed.
+       if (m_inputData.isReadOnce())
+          m_output->flush();
+    }
+}
+
+///==============================================================================
+/// @brief Writes the header of a level in a bulk transformation.
+/// @param currentLevel Level whose output follows.
+///==============================================================================
+void
+Caesar_t::writeLevelHeader(const int currentLevel){
+
+    m_output->write("[+]--- Level: " + std::to_string(currentLevel) + " ---\n");
+    m_output->write("[+] \n");
+}
+
+///==============================================================================
+/// @brief Writes the footer of a level in a bulk transformation. The output
+///        is written at the end of every level.
+///==============================================================================
+void
+Caesar_t::writeLevelFooter(){
+
+    m_output->write("[+]----------------------------------------------------------------------\n");
+    m_output->write("[+] \n");
+    m_output->flush();
+}
+
+///==============================================================================
+/// @brief Writes the summary of --stats on the standard error. The characters
+///        of the input are counted now, after the run, so its times don't
+///        change: from memory if it was loaded, or read again from its file if
+///        it was streamed or rewritten in place, since a shift keeps the class
+///        of every character.
+///==============================================================================
+void
+Caesar_t::writeStats(){
+
+    const std::string_view data  { m_inputData.getData() };
+    std::error_code        eCode { };
+
+    m_stats.addTime(parsingPhase, m_inputData.getParsingTime());
+
+    if (!data.empty()){
+       m_stats.addBytesIn(data.size());
+       m_stats.countCharacters(m_inputData.getLanguage(), data);
+    }
+    else if (m_inputData.isFromFile() && !m_inputData.isReadOnce() && (m_inputData.isStreaming() || m_inputData.isInPlace())){
+       BlockReader_t    reader { m_inputData.getPath(), m_inputData.getBufferSize() };
+       std::string_view block  { };
+
+       while (reader.next(block)){
+          m_stats.countCharacters(m_inputData.getLanguage(), block);
+
+          if (m_inputData.isInPlace())
+             m_stats.addBytesIn(block.size());
+       }
+    }
+
+    //The output mapped in a file or rewritten in place isn't written through the sink.
+    if (m_output != nullptr)
+       m_stats.addBytesOut(m_output->getBytesWritten());
+    else if (m_inputData.hasOutputFile() || m_inputData.isInPlace()){
+       const std::uintmax_t size { std::filesystem::file_size(m_inputData.isInPlace() ? m_inputData.getPath() : m_inputData.getOutputPath(), eCode) };
+
+       if (!eCode)
+          m_stats.addBytesOut(size);
+    }
+
+    m_stats.write();
+}
+
+///==============================================================================
+/// @brief Writes the hardware counters of every stage of the transformation on
+///        the standard error, measured after the run over the start of its
+///        input: from memory if it was loaded, or read again from its file if
+///        it was streamed or rewritten in place. Without a specific level, the
+///        first one is measured.
+///==============================================================================
+void
+Caesar_t::writePerf(){
+
+    const int        level   { m_inputData.getLevel() > 0 ? m_inputData.getLevel() : MIN_LEVEL };
+    std::string_view data    { m_inputData.getData() };
+    std::string      start   { };
+    StageProfile_t   profile { m_inputData };
+
+    if (data.empty() && m_inputData.isFromFile() && !m_inputData.isReadOnce()){
+       BlockReader_t    reader { m_inputData.getPath(), m_inputData.getBufferSize() };
+       std::string_view block  { };
+
+       while (start.size() < StageProfile_t::MAX_BYTES && reader.next(block))
+          start.append(block);
+
+       data= start;
+    }
+
+    if (data.empty()){
+       std::cerr << "[+] The stages can't be measured: there is no input in memory or in a file. \n";
+       return;
+    }
+
+    profile.run(data, level);
+    profile.write();
 }
 
 } // SherpadCaesar
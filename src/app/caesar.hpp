@@ -1,8 +1,17 @@
 // SPDX-License-Identifier: GPL-v3.0
 #pragma once
 
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "dat/utils/utils.hpp"
+#include "eng/bulkTransformer.hpp"
+#include "eng/cribSearcher.hpp"
+#include "eng/frequencyAnalyzer.hpp"
+#include "eng/engine.hpp"
+#include "io/outputSink.hpp"
+#include "stats/runStats.hpp"
 
 /// @class Caesar_t
 /// @brief Manages the actions to be performed based on the data from the Data_t class.
@@ -23,6 +32,12 @@ class Data_t;
                                                 /// @brief Contains the data that the program will work with.
                                       Data_t&   m_inputData;
 
+                                                /// @brief Writes the result of the transformations to the standard output or to the output file.
+                std::unique_ptr<OutputSink_t>   m_output;
+
+                                                /// @brief Times, bytes and allocations of the run, written by --stats.
+                                   RunStats_t   m_stats;
+
                                         void    writeHelp()                                                    const noexcept;
                                         void    writeInfo()                                                    const noexcept;
                                         void    writeWarranty()                                                const noexcept;
@@ -34,9 +49,28 @@ class Data_t;
                                         void    askSpecificLanguage();
                                         void    askLevel();
                                         void    askForSpecificLevel();
-                                        void    bulkEncryptionOrDecryption(const std::string&)                 const noexcept;
-                                        void    encryptionOrDecryption(const std::string&, const int)          const noexcept;
-                                        void    transform(const std::string&, const int)                       const noexcept;
+                                        void    bulkEncryptionOrDecryption(const std::string_view, const std::vector<int>&);
+                                        void    encryptionOrDecryption(const std::string_view, const int);
+                                        void    transform(const std::string_view, const Engine_t&);
+                                        void    mapEncryptionOrDecryption(const std::string_view, const Engine_t&)       const;
+                                        void    inPlaceEncryptionOrDecryption()                                     const;
+                                        void    batchEncryptionOrDecryption()                                       const;
+                                        void    mirrorEncryptionOrDecryption()                                      const;
+                                        void    crackEncryptionOrDecryption();
+                            std::vector<int>    rankLevels(const FrequencyAnalyzer_t&);
+                                        void    cribEncryptionOrDecryption()                                        const;
+                                        bool    writeCribMatches(const std::vector<Language_t>&, const std::string_view, const std::string_view) const;
+                                        void    buildIndex()                                                        const;
+                                        void    rewriteInPlace(char*, const std::size_t, const Engine_t&)          const;
+                                        void    openOutput();
+                                        bool    isOutputTheInput()                                             const noexcept;
+                                        bool    isOutputMappable()                                             const noexcept;
+                                        void    streamEncryptionOrDecryption();
+                                        void    streamLevel(const int, const bool= true);
+                                        void    writeLevelHeader(const int);
+                                        void    writeLevelFooter();
+                                        void    writeStats();
+                                        void    writePerf();
 
         public:
                explicit                         Caesar_t(Data_t&);
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-v3.0
+#ifndef SHERPAD_CAESAR_H
+#define SHERPAD_CAESAR_H
+
+/// C interface of libcaesar, for callers through a foreign function interface such as Python's ctypes or Go's cgo.
+/// An engine is built once per language, direction and level and can be shared by any number of threads. No call
+/// allocates but caesar_engine_new, and no C++ exception crosses this interface.
+
+#include <stddef.h>
+
+/// @brief Marks the functions exported by libcaesar.so, which is built with -fvisibility=hidden.
+#if defined(__GNUC__)
+#  define CAESAR_API __attribute__((visibility("default")))
+#else
+#  define CAESAR_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Engine of a language, direction and level. Its layout is private.
+typedef struct caesar_engine caesar_engine;
+
+/// @brief A piece of memory: a string of the batch, without a terminating null.
+typedef struct caesar_span{
+    const char* data;
+    size_t      length;
+} caesar_span;
+
+/// @brief Languages of the alphabets.
+enum { CAESAR_ENGLISH= 0, CAESAR_SPANISH= 1 };
+
+/// @brief Directions of the transformation.
+enum { CAESAR_ENCRYPT= 0, CAESAR_DECRYPT= 1 };
+
+/// @brief Results of the calls.
+enum { CAESAR_OK= 0, CAESAR_INVALID_ARGUMENT= -1, CAESAR_BUFFER_TOO_SMALL= -2 };
+
+/// @brief Length written for the strings of a batch that didn't fit in the output.
+#define CAESAR_NOT_WRITTEN ((size_t) -1)
+
+///==============================================================================
+/// @brief Builds an engine.
+/// @param language CAESAR_ENGLISH or CAESAR_SPANISH.
+/// @param direction CAESAR_ENCRYPT or CAESAR_DECRYPT.
+/// @param level From 1 to 25 in English, or to 26 in Spanish.
+/// @return The engine, or NULL if a parameter isn't valid or there is no
+///         memory. It must be freed with caesar_engine_free.
+///==============================================================================
+CAESAR_API caesar_engine* caesar_engine_new(int language, int direction, int level);
+
+///==============================================================================
+/// @brief Frees an engine. No call on it may be running.
+/// @param engine Engine to free. It can be NULL.
+///==============================================================================
+CAESAR_API void caesar_engine_free(caesar_engine* engine);
+
+///==============================================================================
+/// @brief Gets the size of the output needed to transform a text. For a batch,
+///        the size for the sum of the lengths of its strings is enough.
+/// @param engine Engine of the transformation.
+/// @param length Size of the text in bytes.
+/// @return The number of bytes that the output must have, or 0 if the engine
+///         is NULL.
+///==============================================================================
+CAESAR_API size_t caesar_max_output_length(const caesar_engine* engine, size_t length);
+
+///==============================================================================
+/// @brief Transforms a text.
+/// @param engine Engine of the transformation.
+/// @param input Text to transform. It is UTF-8 and needs no terminating null.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text is written. It can't overlap the
+///        input.
+/// @param capacity Size of the output in bytes. It must be at least
+///        caesar_max_output_length(engine, length).
+/// @param written Where the size of the transformed text is stored.
+/// @return CAESAR_OK, CAESAR_INVALID_ARGUMENT or CAESAR_BUFFER_TOO_SMALL.
+///==============================================================================
+CAESAR_API int caesar_transform(const caesar_engine* engine, const char* input, size_t length, char* output, size_t capacity, size_t* written);
+
+///==============================================================================
+/// @brief Transforms many strings in a single call, written one after another
+///        in the output, so the cost of crossing the interface is paid once.
+/// @param engine Engine of the transformation.
+/// @param inputs Strings to transform.
+/// @param count Number of strings.
+/// @param output Where the transformed strings are written, in order and
+///        without separators. It can't overlap the inputs.
+/// @param capacity Size of the output in bytes.
+/// @param lengths Where the size of every transformed string is stored. It
+///        has count elements.
+/// @return CAESAR_OK, CAESAR_INVALID_ARGUMENT or CAESAR_BUFFER_TOO_SMALL. If
+///         the output is too small, the strings before the first that didn't
+///         fit are written, and the rest get CAESAR_NOT_WRITTEN as length.
+///==============================================================================
+CAESAR_API int caesar_transform_batch(const caesar_engine* engine, const caesar_span* inputs, size_t count, char* output, size_t capacity, size_t* lengths);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SHERPAD_CAESAR_H
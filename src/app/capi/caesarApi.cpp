@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <new>
+#include "../eng/engine.hpp"
+#include "caesar.h"
+
+//The values of the C interface are the ones of the engine, so they are converted with a cast.
+static_assert(CAESAR_ENGLISH == static_cast<int>(SherpadCaesar::englishLanguage) && CAESAR_SPANISH == static_cast<int>(SherpadCaesar::spanishLanguage));
+static_assert(CAESAR_ENCRYPT == static_cast<int>(SherpadCaesar::encryptDirection) && CAESAR_DECRYPT == static_cast<int>(SherpadCaesar::decryptDirection));
+
+/// @brief Engine of the C interface.
+struct caesar_engine{
+                                                              /// @brief Engine of the language, direction and level.
+                                    SherpadCaesar::Engine_t   engine;
+};
+
+///==============================================================================
+/// @brief Builds an engine. Any exception becomes NULL.
+/// @param language CAESAR_ENGLISH or CAESAR_SPANISH.
+/// @param direction CAESAR_ENCRYPT or CAESAR_DECRYPT.
+/// @param level From 1 to the maximum level of the language.
+/// @return The engine, or NULL.
+///==============================================================================
+caesar_engine*
+caesar_engine_new(const int language, const int direction, const int level){
+
+    //An int out of the enumeration can't be cast to it.
+    if ((language != CAESAR_ENGLISH && language != CAESAR_SPANISH) || (direction != CAESAR_ENCRYPT && direction != CAESAR_DECRYPT))
+       return nullptr;
+
+    try{
+       return new caesar_engine { SherpadCaesar::Engine_t { static_cast<SherpadCaesar::Language_t>(language), static_cast<SherpadCaesar::Direction_t>(direction), level } };
+    }
+    catch (...){
+       return nullptr;
+    }
+}
+
+///==============================================================================
+/// @brief Frees an engine.
+/// @param engine Engine to free. It can be NULL.
+///==============================================================================
+void
+caesar_engine_free(caesar_engine* engine){
+
+    delete engine;
+}
+
+///==============================================================================
+/// @brief Gets the size of the output needed to transform a text.
+/// @param engine Engine of the transformation.
+/// @param length Size of the text in bytes.
+/// @return The number of bytes that the output must have, or 0 if the engine
+///         is NULL.
+///==============================================================================
+size_t
+caesar_max_output_length(const caesar_engine* engine, const size_t length){
+
+    return engine != nullptr ? engine->engine.getMaxOutputLength(length) : 0;
+}
+
+///==============================================================================
+/// @brief Transforms a text.
+/// @param engine Engine of the transformation.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text is written.
+/// @param capacity Size of the output in bytes.
+/// @param written Where the size of the transformed text is stored.
+/// @return CAESAR_OK, CAESAR_INVALID_ARGUMENT or CAESAR_BUFFER_TOO_SMALL.
+///==============================================================================
+int
+caesar_transform(const caesar_engine* engine, const char* input, const size_t length, char* output, const size_t capacity, size_t* written){
+
+    if (engine == nullptr || (input == nullptr && length > 0) || output == nullptr || written == nullptr)
+       return CAESAR_INVALID_ARGUMENT;
+
+    if (capacity < engine->engine.getMaxOutputLength(length))
+       return CAESAR_BUFFER_TOO_SMALL;
+
+    *written= engine->engine.transform(std::string_view { input, length }, output);
+
+    return CAESAR_OK;
+}
+
+///==============================================================================
+/// @brief Transforms many strings, one after another in the output. Every
+///        string only needs room for its own maximum length, and the bytes
+///        past its real output are taken by the next one.
+/// @param engine Engine of the transformation.
+/// @param inputs Strings to transform.
+/// @param count Number of strings.
+/// @param output Where the transformed strings are written.
+/// @param capacity Size of the output in bytes.
+/// @param lengths Where the size of every transformed string is stored.
+/// @return CAESAR_OK, CAESAR_INVALID_ARGUMENT or CAESAR_BUFFER_TOO_SMALL.
+///==============================================================================
+int
+caesar_transform_batch(const caesar_engine* engine, const caesar_span* inputs, const size_t count, char* output, const size_t capacity, size_t* lengths){
+
+    size_t used { 0 };
+
+    if (engine == nullptr || (count > 0 && (inputs == nullptr || output == nullptr || lengths == nullptr)))
+       return CAESAR_INVALID_ARGUMENT;
+
+    for (size_t i= 0; i < count; i++)
+       if (inputs[i].data == nullptr && inputs[i].length > 0)
+          return CAESAR_INVALID_ARGUMENT;
+
+    for (size_t i= 0; i < count; i++){
+       if (capacity - used < engine->engine.getMaxOutputLength(inputs[i].length)){
+          for (size_t j= i; j < count; j++)
+             lengths[j]= CAESAR_NOT_WRITTEN;
+
+          return CAESAR_BUFFER_TOO_SMALL;
+       }
+
+       lengths[i]= engine->engine.transform(std::string_view { inputs[i].data, inputs[i].length }, output + used);
+       used+= lengths[i];
+    }
+
+    return CAESAR_OK;
+}
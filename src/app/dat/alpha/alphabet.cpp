@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include "../utils/utf8.hpp"
+#include "alphabet.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the Alphabet_t class.
+/// @param alphabet String containing all the characters of the language in
+///        UTF-8.
+///==============================================================================
+Alphabet_t::Alphabet_t(const std::string_view alphabet)
+    : m_text { alphabet } {
+
+    std::size_t pivot { 0 };
+
+    while (pivot < m_text.length()){
+       const int      length    { utf8Length(static_cast<unsigned char>(m_text[pivot])) };
+       const char32_t codePoint { static_cast<char32_t>(decodeUTF8(m_text.data() + pivot, length)) };
+
+       m_positions.emplace(codePoint, static_cast<int>(m_codePoints.size()));
+       m_codePoints.push_back(codePoint);
+       m_characters.push_back(m_text.substr(pivot, length));
+
+       pivot+= length;
+    }
+}
+
+///==============================================================================
+/// @brief Gets the number of letters of the alphabet.
+/// @return The number of letters.
+///==============================================================================
+int
+Alphabet_t::getSize() const noexcept{
+
+    return static_cast<int>(m_codePoints.size());
+}
+
+///==============================================================================
+/// @brief Searches for a letter in the alphabet.
+/// @param codePoint Code point of the letter.
+/// @return The position of the letter, or -1 if it isn't in the alphabet.
+///==============================================================================
+int
+Alphabet_t::find(const char32_t codePoint) const noexcept{
+
+    const auto found { m_positions.find(codePoint) };
+
+    return (found != m_positions.end()) ? found->second : -1;
+}
+
+///==============================================================================
+/// @brief Calculates the position of a letter after shifting it.
+/// @param position Current position of the letter.
+/// @param currentLevel Positions to shift. It is positive to encrypt and
+///        negative to decrypt.
+/// @return The new position, wrapping around the alphabet.
+///==============================================================================
+int
+Alphabet_t::shift(const int position, const int currentLevel) const noexcept{
+
+    const int size { getSize() };
+
+    return ((position + currentLevel) % size + size) % size;
+}
+
+///==============================================================================
+/// @brief Gets the code point of a letter.
+/// @param position Position of the letter.
+/// @return The code point.
+///==============================================================================
+char32_t
+Alphabet_t::getCodePoint(const int position) const noexcept{
+
+    return m_codePoints[position];
+}
+
+///==============================================================================
+/// @brief Gets the UTF-8 bytes of a letter.
+/// @param position Position of the letter.
+/// @return The letter in UTF-8.
+///==============================================================================
+const std::string&
+Alphabet_t::getCharacter(const int position) const noexcept{
+
+    return m_characters[position];
+}
+
+///==============================================================================
+/// @brief Gets the alphabet in UTF-8.
+/// @return m_text that contains the alphabet.
+///==============================================================================
+const std::string&
+Alphabet_t::getText() const noexcept{
+
+    return m_text;
+}
+
+///==============================================================================
+/// @brief Gets the code points of the alphabet.
+/// @return m_codePoints that contains the code point of every letter.
+///==============================================================================
+const std::vector<char32_t>&
+Alphabet_t::getCodePoints() const noexcept{
+
+    return m_codePoints;
+}
+
+} // namespace SherpadCaesar
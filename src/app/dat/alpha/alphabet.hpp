@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @class Alphabet_t
+/// @brief Stores an alphabet as decoded code points with a reverse map from code point to position, so that looking up
+///        a letter and shifting it take constant time whatever the level, the direction or the UTF-8 size of the letter.
+
+    class Alphabet_t{
+        private:
+                                                              /// @brief The alphabet in UTF-8.
+                                                std::string   m_text              { "" };
+
+                                                              /// @brief Code point of every letter, by position.
+                                      std::vector<char32_t>   m_codePoints        { };
+
+                                                              /// @brief UTF-8 bytes of every letter, by position.
+                                   std::vector<std::string>   m_characters        { };
+
+                                                              /// @brief Position of every letter, by code point.
+                            std::unordered_map<char32_t, int> m_positions         { };
+
+        public:
+                explicit                                      Alphabet_t(const std::string_view);
+                                                              Alphabet_t(const Alphabet_t&)              = default;
+                                                              Alphabet_t(      Alphabet_t&&)             = default;
+                                                             ~Alphabet_t()                               = default;
+                                                Alphabet_t&   operator=(const Alphabet_t&)               = default;
+                                                Alphabet_t&   operator=(      Alphabet_t&&)              = default;
+                                                        int   getSize()                            const noexcept;
+                                                        int   find(const char32_t)                 const noexcept;
+                                                        int   shift(const int, const int)          const noexcept;
+                                                   char32_t   getCodePoint(const int)              const noexcept;
+                                         const std::string&   getCharacter(const int)              const noexcept;
+                                         const std::string&   getText()                            const noexcept;
+                               const std::vector<char32_t>&   getCodePoints()                      const noexcept;
+    };
+
+} // namespace SherpadCaesar
@@ -1,10 +1,14 @@
 // SPDX-License-Identifier: GPL-v3.0
 #include <algorithm>
-#include <fstream>
+#include <cctype>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include "../trace/probes.hpp"
 #include "args/arguments.hpp"
 #include "excep/caesarException.hpp"
+#include "utils/utf8.hpp"
 #include "data.hpp"
 
 namespace SherpadCaesar {
@@ -15,6 +19,8 @@ namespace SherpadCaesar {
 ///==============================================================================
 Data_t::Data_t(Arguments_t& args){
 
+    const std::chrono::steady_clock::time_point start { std::chrono::steady_clock::now() };
+
     if (!args.isEmpty()){
        std::vector<std::string>& allArguments { args.getAllArguments() };
 
@@ -24,6 +30,8 @@ Data_t::Data_t(Arguments_t& args){
        if (m_flagsWithParameters != 0)
            throw CaesarException_t(EXCEPTION_5);
     }
+
+    m_parsingTime= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
 ///==============================================================================
@@ -65,6 +73,7 @@ void
 Data_t::initLevel() noexcept{
     m_flagLevel= false;
     m_level= 0;
+    m_levels.clear();
 }
 
 ///==============================================================================
@@ -79,40 +88,16 @@ Data_t::assignInformation(std::string& cArg){
     bool isArgValid { false };
 
     if (!m_nextParameters.empty()){
-       switch (m_nextParameters.front()){
-          case CHARACTER_k:
-             if ((m_flagLanguage && m_language == STRING_EMPTY.data()) && (isAValidLanguage(cArg))){
-                isArgValid= true;
-                m_language= std::move(cArg);
-                loadOtherAlphabet();
-             }
-             break;
-          case CHARACTER_s:
-             if (m_flagString && m_data == STRING_EMPTY.data()){
-                isArgValid= true;
-                m_data= std::move(cArg);
-             }
-             break;
-          case CHARACTER_f:
-             if ((m_flagFile && m_path == STRING_EMPTY.data()) && (isAValidPath(cArg))){
-                isArgValid= true;
-                m_path= std::move(cArg);
-                loadDataFromFile(m_path, m_data);
-             }
-             break;
-          case CHARACTER_l:
-             if ((m_flagLevel && m_level == 0) && (isAValidLevelValue(cArg))){
-                isArgValid= true;
-                m_level= std::stoi(cArg.data());
-             }
-             break;
-          default:
-             throw CaesarException_t(EXCEPTION_2);
-       }
+       isArgValid= assignParameter(m_nextParameters.front(), cArg);
 
        m_nextParameters.pop();
        m_flagsWithParameters--;
     }
+    else if (m_flagBatch || m_flagBuildIndex){
+       //After --batch or --build-index, the arguments that aren't values of a flag are the files of the batch.
+       isArgValid= true;
+       m_batchPaths.push_back(std::move(cArg));
+    }
     else{
        throw CaesarException_t(EXCEPTION_1);
     }
@@ -120,6 +105,143 @@ Data_t::assignInformation(std::string& cArg){
     return isArgValid;
 }
 
+///==============================================================================
+/// @brief Stores the value of a flag that requires parameters.
+/// @param parameter Flag that the value belongs to.
+/// @param cArg Value to store.
+/// @return isArgValid Indicates whether the value is valid or not.
+///==============================================================================
+bool
+Data_t::assignParameter(const char parameter, std::string& cArg){
+
+    bool             isArgValid { false };
+    std::vector<int> levels     { };
+
+    switch (parameter){
+       case CHARACTER_k:
+          if ((m_flagLanguage && m_language == STRING_EMPTY.data()) && (isAValidLanguage(cArg))){
+             isArgValid= true;
+             m_language= std::move(cArg);
+             loadOtherAlphabet();
+          }
+          break;
+       case CHARACTER_s:
+          if (m_flagString && m_data == STRING_EMPTY.data()){
+             isArgValid= true;
+             m_data= std::move(cArg);
+          }
+          break;
+       case CHARACTER_f:
+          //The file is loaded later, when it is known whether it will be read in blocks.
+          if ((m_flagFile && m_path == STRING_EMPTY.data()) && (cArg == STANDARD_INPUT_PATH || isAValidInputPath(cArg))){
+             isArgValid= true;
+             m_path= std::move(cArg);
+          }
+          break;
+       case CHARACTER_l:
+          if ((m_flagLevel && m_level == 0 && m_levels.empty()) && (isAValidLevelList(cArg, levels))){
+             isArgValid= true;
+
+             if (levels.size() == 1)
+                m_level= levels.front();
+             else
+                m_levels= std::move(levels);
+          }
+          break;
+       case CHARACTER_o:
+          if ((m_flagOutput && m_outputPath == STRING_EMPTY.data()) && (isAValidOutputPath(cArg))){
+             isArgValid= true;
+             m_outputPath= std::move(cArg);
+          }
+          break;
+       case PARAMETER_ISA:
+          if (isAValidIsa(cArg)){
+             isArgValid= true;
+             m_isa= getIsaFromName(cArg);
+          }
+          break;
+       case PARAMETER_THREADS:
+          if (isAValidThreads(cArg)){
+             isArgValid= true;
+             m_threads= std::stoi(cArg);
+          }
+          break;
+       case PARAMETER_BUFFER_SIZE:
+          if (isAValidBufferSize(cArg)){
+             isArgValid= true;
+             m_bufferSize= getSizeFromText(cArg);
+          }
+          break;
+       case PARAMETER_BATCH:
+          if (m_batchDirectory == STRING_EMPTY.data() && isAValidDirectory(cArg)){
+             isArgValid= true;
+             m_batchDirectory= std::move(cArg);
+          }
+          break;
+       case PARAMETER_LIST:
+          if (isAValidPath(cArg) && loadBatchList(cArg))
+             isArgValid= true;
+          break;
+       case PARAMETER_TOP:
+          if (isAValidTop(cArg)){
+             isArgValid= true;
+             m_top= std::stoi(cArg);
+          }
+          break;
+       case PARAMETER_SAMPLE:
+          if (isAValidSampleSize(cArg)){
+             isArgValid= true;
+             m_sampleSize= getSizeFromText(cArg);
+          }
+          break;
+       case PARAMETER_CRIB:
+          if (m_crib == STRING_EMPTY.data() && !cArg.empty()){
+             isArgValid= true;
+             m_crib= std::move(cArg);
+          }
+          else
+             std::cout << "[+] Invalid crib. You must enter the known piece of the plaintext once. \n";
+          break;
+       case PARAMETER_BUILD_INDEX:
+          if (m_indexPath == STRING_EMPTY.data() && isAValidOutputPath(cArg)){
+             isArgValid= true;
+             m_indexPath= std::move(cArg);
+          }
+          break;
+       case PARAMETER_INDEX:
+          if (m_indexPath == STRING_EMPTY.data() && isAValidPath(cArg)){
+             isArgValid= true;
+             m_indexPath= std::move(cArg);
+          }
+          break;
+       case PARAMETER_MIRROR:
+          if (m_mirrorDirectory == STRING_EMPTY.data() && isAValidDirectory(cArg)){
+             isArgValid= true;
+             m_mirrorDirectory= std::move(cArg);
+          }
+          break;
+       case PARAMETER_TRACE:
+          if (m_tracePath == STRING_EMPTY.data() && isAValidOutputPath(cArg)){
+             isArgValid= true;
+             m_tracePath= std::move(cArg);
+          }
+          break;
+       default:
+          throw CaesarException_t(EXCEPTION_2);
+    }
+
+    return isArgValid;
+}
+
+///==============================================================================
+/// @brief Loads the content of the file to transform, unless it is a string.
+///==============================================================================
+void
+Data_t::loadData(){
+
+    if (isFromFile() && !m_inputFile.has_value())
+       loadDataFromFile(m_path);
+}
 
 ///==============================================================================
 /// @brief Returns the flag's help.
@@ -249,6 +371,182 @@ Data_t::isSpecific() const noexcept{
     return (m_flagLevel && m_level > 0);
 }
 
+///==============================================================================
+/// @brief Indicates whether the transformation is at a list of levels.
+/// @return true whether level's flag is activated and more than one level was
+///         selected.
+///==============================================================================
+bool
+Data_t::isMultiLevel() const noexcept{
+
+    return (m_flagLevel && !m_levels.empty());
+}
+
+///==============================================================================
+/// @brief Indicates whether the file is transformed in blocks.
+/// @return true whether stream's flag is activated and the data comes from a
+///         file.
+///==============================================================================
+bool
+Data_t::isStreaming() const noexcept{
+
+    //The standard input or a pipe can only be read once, so it is only streamed at a specific level.
+    if (isReadOnce())
+       return isSpecific();
+
+    return (m_flagStream && isFromFile());
+}
+
+///==============================================================================
+/// @brief Indicates whether the input can be read only once: the standard
+///        input, a pipe or a character device. It can't be read again, mapped
+///        or rewritten in place.
+/// @return true whether the data comes from a file that isn't a regular file.
+///==============================================================================
+bool
+Data_t::isReadOnce() const noexcept{
+
+    std::error_code eCode;
+
+    return (isFromStandardInput() || (isFromFile() && !std::filesystem::is_regular_file(m_path, eCode)));
+}
+
+///==============================================================================
+/// @brief Indicates whether the data is read from the standard input.
+/// @return true whether the path of the file is "-".
+///==============================================================================
+bool
+Data_t::isFromStandardInput() const noexcept{
+
+    return (isFromFile() && m_path == STANDARD_INPUT_PATH);
+}
+
+///==============================================================================
+/// @brief Indicates whether many files are transformed at once.
+/// @return true whether batch's flag is activated.
+///==============================================================================
+bool
+Data_t::isBatch() const noexcept{
+
+    return m_flagBatch;
+}
+
+///==============================================================================
+/// @brief Indicates whether the levels that most likely decrypt the input are
+///        searched instead of writing all of them.
+/// @return true whether crack's flag is activated.
+///==============================================================================
+bool
+Data_t::isCrack() const noexcept{
+
+    return m_flagCrack;
+}
+
+///==============================================================================
+/// @brief Indicates whether the levels at which a known piece of the plaintext
+///        appears in the input are searched instead of transforming it.
+/// @return true whether crib's flag is activated.
+///==============================================================================
+bool
+Data_t::isCrib() const noexcept{
+
+    return m_flagCrib;
+}
+
+///==============================================================================
+/// @brief Indicates whether a summary of the run is written on the standard
+///        error when it finishes.
+/// @return true whether stats' flag is activated.
+///==============================================================================
+bool
+Data_t::isStats() const noexcept{
+
+    return m_flagStats;
+}
+
+///==============================================================================
+/// @brief Indicates whether the stages of the transformation are measured with
+///        the hardware counters when the run finishes.
+/// @return true whether perf's flag is activated.
+///==============================================================================
+bool
+Data_t::isPerf() const noexcept{
+
+    return m_flagPerf;
+}
+
+///==============================================================================
+/// @brief Indicates whether a timeline of the run is written.
+/// @return true whether the path of the trace was given.
+///==============================================================================
+bool
+Data_t::isTrace() const noexcept{
+
+    return !m_tracePath.empty();
+}
+
+///==============================================================================
+/// @brief Indicates whether an index of the files is built to search cribs in
+///        them later.
+/// @return true whether build-index's flag is activated.
+///==============================================================================
+bool
+Data_t::isIndexBuild() const noexcept{
+
+    return m_flagBuildIndex;
+}
+
+///==============================================================================
+/// @brief Indicates whether the crib is searched in the files of an index.
+/// @return true whether index's flag is activated.
+///==============================================================================
+bool
+Data_t::isIndexSearch() const noexcept{
+
+    return m_flagIndex;
+}
+
+///==============================================================================
+/// @brief Indicates whether the user selected the language with -k.
+/// @return true whether language's flag is activated and there is a language.
+///==============================================================================
+bool
+Data_t::isLanguageSelected() const noexcept{
+
+    return (m_flagLanguage && m_language != STRING_EMPTY.data());
+}
+
+///==============================================================================
+/// @brief Indicates whether a directory tree is mirrored into the directory of
+///        the batch.
+/// @return true whether mirror's flag is activated.
+///==============================================================================
+bool
+Data_t::isMirror() const noexcept{
+
+    return m_flagMirror;
+}
+
+///==============================================================================
+/// @brief Indicates whether the result is written in a file.
+/// @return true whether output's flag is activated and the path is informed.
+///==============================================================================
+bool
+Data_t::hasOutputFile() const noexcept{
+
+    return (m_flagOutput && m_outputPath != STRING_EMPTY.data());
+}
+
+///==============================================================================
+/// @brief Indicates whether the input file is rewritten with the result.
+/// @return true whether in-place's flag is activated.
+///==============================================================================
+bool
+Data_t::isInPlace() const noexcept{
+
+    return m_flagInPlace;
+}
+
 ///==============================================================================
 /// @brief Sets the encryption flag.
 /// @param fE Value to assign to the encryption flag.
@@ -299,6 +597,22 @@ Data_t::setFlagLanguage(const bool fLg) noexcept{
     m_flagLanguage= fLg;
 }
 
+///==============================================================================
+/// @brief Selects a language and loads its alphabets, like -k does.
+/// @param language Language to select.
+///==============================================================================
+void
+Data_t::setLanguage(const Language_t language){
+
+    m_flagLanguage= true;
+    m_language    = (language == spanishLanguage) ? SPANISH_LANGUAGE.data() : ENGLISH_LANGUAGE.data();
+
+    if (language == spanishLanguage)
+       loadOtherAlphabet();
+    else
+       loadNewAlphabet(englishUppercaseAlphabet, englishLowercaseAlphabet, MAX_LEVEL_ENGLISH);
+}
+
 ///==============================================================================
 /// @brief Sets the level flag.
 /// @param fLv Value to assign to the level flag.
@@ -349,21 +663,207 @@ Data_t::getMaxLevel() const noexcept{
     return m_maxLevel;
 }
 
+///==============================================================================
+/// @brief Gets the levels to transform when there isn't a specific level.
+/// @return The selected list of levels, or every level from the minimum to the
+///         maximum in a bulk transformation.
+///==============================================================================
+std::vector<int>
+Data_t::getLevels() const{
+
+    std::vector<int> levels { m_levels };
+
+    if (levels.empty())
+       for (int currentLevel= m_minLevel; currentLevel <= m_maxLevel; currentLevel++)
+          levels.push_back(currentLevel);
+
+    return levels;
+}
+
 ///==============================================================================
 /// @brief Gets the data to transform.
-/// @return m_data that contains the data to transform.
+/// @return The content of the file if it was loaded, or m_data that contains
+///         the string to transform.
 ///==============================================================================
-const std::string&
+std::string_view
 Data_t::getData() const noexcept{
 
-    return m_data;
+    if (m_inputFile.has_value())
+       return m_inputFile->getContent();
+    else
+       return m_data;
+}
+
+///==============================================================================
+/// @brief Gets the instruction set forced for the ASCII kernels.
+/// @return m_isa that contains the instruction set, automaticIsa if it wasn't
+///         forced.
+///==============================================================================
+Isa_t
+Data_t::getIsa() const noexcept{
+
+    return m_isa;
+}
+
+///==============================================================================
+/// @brief Gets the number of threads chosen for the transformation.
+/// @return m_threads that contains the number of threads, 0 if it wasn't
+///         chosen.
+///==============================================================================
+std::size_t
+Data_t::getThreads() const noexcept{
+
+    return m_threads;
+}
+
+///==============================================================================
+/// @brief Gets the number of the most likely levels written by --crack.
+/// @return m_top that contains the number of levels.
+///==============================================================================
+int
+Data_t::getTop() const noexcept{
+
+    return m_top;
+}
+
+///==============================================================================
+/// @brief Gets the bytes at the start of the input analyzed by --crack.
+/// @return m_sampleSize that contains the size in bytes, or 0 if the whole
+///         input is analyzed.
+///==============================================================================
+std::size_t
+Data_t::getSampleSize() const noexcept{
+
+    return m_sampleSize;
+}
+
+///==============================================================================
+/// @brief Gets the size of the blocks read in streaming mode.
+/// @return m_bufferSize that contains the size of the blocks in bytes.
+///==============================================================================
+std::size_t
+Data_t::getBufferSize() const noexcept{
+
+    return m_bufferSize;
+}
+
+///==============================================================================
+/// @brief Gets the path of the file to transform.
+/// @return m_path that contains the path of the file.
+///==============================================================================
+const std::string&
+Data_t::getPath() const noexcept{
+
+    return m_path;
+}
+
+///==============================================================================
+/// @brief Gets the path of the file where the result is written.
+/// @return m_outputPath that contains the path of the output file.
+///==============================================================================
+const std::string&
+Data_t::getOutputPath() const noexcept{
+
+    return m_outputPath;
+}
+
+///==============================================================================
+/// @brief Gets the directory where the files of the batch are written.
+/// @return m_batchDirectory that contains the path of the directory.
+///==============================================================================
+const std::string&
+Data_t::getBatchDirectory() const noexcept{
+
+    return m_batchDirectory;
+}
+
+///==============================================================================
+/// @brief Gets the source directory of the mirror.
+/// @return m_mirrorDirectory that contains the path of the directory.
+///==============================================================================
+const std::string&
+Data_t::getMirrorDirectory() const noexcept{
+
+    return m_mirrorDirectory;
+}
+
+///==============================================================================
+/// @brief Gets the known piece of the plaintext searched by --crib.
+/// @return m_crib that contains the crib.
+///==============================================================================
+const std::string&
+Data_t::getCrib() const noexcept{
+
+    return m_crib;
+}
+
+///==============================================================================
+/// @brief Gets the path of the index that is built or searched.
+/// @return m_indexPath that contains the path of the index.
+///==============================================================================
+const std::string&
+Data_t::getIndexPath() const noexcept{
+
+    return m_indexPath;
+}
+
+///==============================================================================
+/// @brief Gets the path of the timeline of the run.
+/// @return m_tracePath that contains the path of the trace.
+///==============================================================================
+const std::string&
+Data_t::getTracePath() const noexcept{
+
+    return m_tracePath;
+}
+
+///==============================================================================
+/// @brief Gets the time spent interpreting the arguments.
+/// @return m_parsingTime that contains the time in seconds.
+///==============================================================================
+double
+Data_t::getParsingTime() const noexcept{
+
+    return m_parsingTime;
+}
+
+///==============================================================================
+/// @brief Gets the files of the batch.
+/// @return m_batchPaths that contains the paths of the files, in order.
+///==============================================================================
+const std::vector<std::string>&
+Data_t::getBatchPaths() const noexcept{
+
+    return m_batchPaths;
+}
+
+///==============================================================================
+/// @brief Gets the selected language.
+/// @return spanishLanguage whether the selected language is Spanish, 
+///         englishLanguage otherwise.
+///==============================================================================
+Language_t
+Data_t::getLanguage() const noexcept{
+
+    return isSpanishLanguage() ? spanishLanguage : englishLanguage;
+}
+
+///==============================================================================
+/// @brief Gets the direction of the transformation.
+/// @return decryptDirection whether the user wants to decrypt, 
+///         encryptDirection otherwise.
+///==============================================================================
+Direction_t
+Data_t::getDirection() const noexcept{
+
+    return wantDecrypt() ? decryptDirection : encryptDirection;
 }
 
 ///==============================================================================
 /// @brief Gets the alphabet in uppercase letters.
 /// @return m_alphabetUppercase that contains the alphabet in uppercase letters.
 ///==============================================================================
-const std::string&
+const Alphabet_t&
 Data_t::getAlphabetUppercase() const noexcept{
 
     return m_alphabetUppercase;
@@ -373,7 +873,7 @@ Data_t::getAlphabetUppercase() const noexcept{
 /// @brief Gets the alphabet in lowercase letters.
 /// @return m_alphabetLowercase that contains the alphabet in lowercase letters.
 ///==============================================================================
-const std::string&
+const Alphabet_t&
 Data_t::getAlphabetLowercase() const noexcept{
 
     return m_alphabetLowercase;
@@ -388,21 +888,27 @@ Data_t::getAlphabetLowercase() const noexcept{
 bool
 Data_t::findCharacterData(const std::string& c, DataCharacter_t& dC) const noexcept{
 
-    return (searchCharacter(c, dC, m_alphabetUppercase, capitalLetter) || searchCharacter(c, dC, m_alphabetLowercase, smallLetter));
+    const int  length    { static_cast<int>(c.length()) };
+          long codePoint { -1 };
+
+    if (length > 0 && length == utf8Length(static_cast<unsigned char>(c[0])))
+       codePoint= decodeUTF8(c.data(), length);
+
+    return (codePoint >= 0) &&
+           (searchCharacter(c, codePoint, dC, m_alphabetUppercase, capitalLetter) || searchCharacter(c, codePoint, dC, m_alphabetLowercase, smallLetter));
 }
 
 ///==============================================================================
 /// @brief Gets the transformed character either encrypted or decrypted 
 ///        regard of language.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param initialPosition Current character position in the alphabet.
 /// @param currentLevel Current level to perform the transformation.
 /// @return A character considering the shift and the number of letters in 
 ///         the alphabet.
 ///==============================================================================
 std::string
-Data_t::getTransformedCharacter(const std::string& alphabet, const int initialPosition, const int currentLevel) const noexcept{
+Data_t::getTransformedCharacter(const Alphabet_t& alphabet, const int initialPosition, const int currentLevel) const noexcept{
     
     if (isEnglishLanguage())
        return transformEnglishCharacter(alphabet, initialPosition + currentLevel);
@@ -413,33 +919,28 @@ Data_t::getTransformedCharacter(const std::string& alphabet, const int initialPo
 ///==============================================================================
 /// @brief Gets the transformed character either encrypted or decrypted in 
 ///        English language.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param scrolling Shift for performing the transformation.
 /// @return A character considering the shift and the number of letters in 
 ///         the English alphabet.
 ///==============================================================================
 std::string
-Data_t::transformEnglishCharacter(const std::string& alphabet, const int scrolling) const noexcept{
+Data_t::transformEnglishCharacter(const Alphabet_t& alphabet, const int scrolling) const noexcept{
     
-    if (scrolling >= 0)
-       return alphabet.substr(scrolling % alphabet.length(), 1);
-    else
-       return alphabet.substr((alphabet.length() + scrolling) % alphabet.length(), 1);
+    return alphabet.getCharacter(alphabet.shift(0, scrolling));
 }
 
 ///==============================================================================
 /// @brief Gets the transformed character either encrypted or decrypted in 
 ///        other language.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param initialPosition Current character position in the alphabet.
 /// @param currentLevel Current level to perform the transformation.
 /// @return A character considering the shift and the number of letters in 
 ///         other alphabet.
 ///==============================================================================
 std::string
-Data_t::transformOtherLanguageCharacter(const std::string& alphabet, const int initialPosition, const int currentLevel) const noexcept{
+Data_t::transformOtherLanguageCharacter(const Alphabet_t& alphabet, const int initialPosition, const int currentLevel) const noexcept{
     
     if (currentLevel > 0)
        return getEncryptedCharacter(alphabet, initialPosition, currentLevel);
@@ -449,58 +950,29 @@ Data_t::transformOtherLanguageCharacter(const std::string& alphabet, const int i
 
 ///==============================================================================
 /// @brief Gets the transformed character to encrypt in other language.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param initialPosition Current character position in the alphabet.
 /// @param currentLevel Current level to perform the transformation.
 /// @return A character encrypted.
 ///==============================================================================
 std::string
-Data_t::getEncryptedCharacter(const std::string& alphabet, const int initialPosition, const int currentLevel) const noexcept{
+Data_t::getEncryptedCharacter(const Alphabet_t& alphabet, const int initialPosition, const int currentLevel) const noexcept{
     
-    int currentPosition { initialPosition };
-    int length          { getUTF8CharLength(static_cast<unsigned char>(alphabet[currentPosition])) };
-    int distance        { currentLevel };
-    
-    while (distance > 0){
-       currentPosition= (currentPosition + length) % alphabet.length();
-                length= getUTF8CharLength(static_cast<unsigned char>(alphabet[currentPosition]));
-
-       distance--;
-    }
-                     
-    return alphabet.substr(currentPosition, length);
+    return alphabet.getCharacter(alphabet.shift(initialPosition, currentLevel));
 }
 
 ///==============================================================================
 /// @brief Gets the transformed character to decrypt in other language.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param initialPosition Current character position in the alphabet.
-/// @param currentLevel Current level to perform the transformation.
+/// @param currentLevel Current level to perform the transformation. It is 
+///        negative.
 /// @return A character decrypted.
 ///==============================================================================
 std::string
-Data_t::getDecryptedCharacter(const std::string& alphabet, const int initialPosition, const int currentLevel) const noexcept{
-    
-    int currentPosition { initialPosition };
-    int length          { getUTF8CharLength(static_cast<unsigned char>(alphabet[currentPosition])) };
-    int distance        { currentLevel };
+Data_t::getDecryptedCharacter(const Alphabet_t& alphabet, const int initialPosition, const int currentLevel) const noexcept{
     
-    while (distance < 0){
-       currentPosition= nextDecryptPosition(currentPosition,alphabet);
-       length= getUTF8CharLength(static_cast<unsigned char>(alphabet[currentPosition]));
-       
-       //We reposition until we find the start of a UTF-8 characters.
-       while (length < 0){
-          currentPosition= nextDecryptPosition(currentPosition,alphabet);
-                   length= getUTF8CharLength(static_cast<unsigned char>(alphabet[currentPosition]));
-       }
-
-       distance++;
-    }
-                     
-    return alphabet.substr(currentPosition, length);
+    return alphabet.getCharacter(alphabet.shift(initialPosition, currentLevel));
 }
 
 ///==============================================================================
@@ -508,7 +980,7 @@ Data_t::getDecryptedCharacter(const std::string& alphabet, const int initialPosi
 ///        diferent to English.
 ///==============================================================================
 void
-Data_t::loadOtherAlphabet() noexcept{
+Data_t::loadOtherAlphabet(){
     
     if (isSpanishLanguage())
         loadNewAlphabet(spanishUppercaseAlphabet, spanishLowercaseAlphabet, MAX_LEVEL_SPANISH);    
@@ -522,10 +994,10 @@ Data_t::loadOtherAlphabet() noexcept{
 /// @param loc Locale settings of the language.
 ///==============================================================================
 void   
-Data_t::loadNewAlphabet(const std::string_view uppercase, const std::string_view lowercase, const int maxLevel) noexcept{
+Data_t::loadNewAlphabet(const std::string_view uppercase, const std::string_view lowercase, const int maxLevel){
 
-    m_alphabetUppercase= uppercase.data();
-    m_alphabetLowercase= lowercase.data();
+    m_alphabetUppercase= Alphabet_t { uppercase };
+    m_alphabetLowercase= Alphabet_t { lowercase };
     m_maxLevel= maxLevel;
 }
 
@@ -588,6 +1060,11 @@ Data_t::processArgument(std::string& cArg){
               m_nextParameters.emplace(lowerChar);
               m_flagsWithParameters++;
               break;
+           case CHARACTER_o:
+              m_flagOutput= true;
+              m_nextParameters.emplace(lowerChar);
+              m_flagsWithParameters++;
+              break;
            default:
               throw CaesarException_t(EXCEPTION_0);
         }
@@ -595,13 +1072,105 @@ Data_t::processArgument(std::string& cArg){
 
     switch (cArg.front()){
        case CHARACTER_less:
-          std::for_each(cArg.begin() + 1, cArg.end(), processFlags);
+          //A lone '-' isn't a flag, it is the standard input.
+          if (cArg == STANDARD_INPUT_PATH)
+             assignInformation(cArg);
+          else if (cArg.length() > 1 && cArg[1] == CHARACTER_less)
+             processLongFlag(cArg.substr(2));
+          else
+             std::for_each(cArg.begin() + 1, cArg.end(), processFlags);
           break;
        default:
           assignInformation(cArg);
     }
 }
 
+///==============================================================================
+/// @brief Interprets a long flag. If it requires a value, the value can come
+///        after '=' or as a later argument.
+/// @param cFlag Current flag to process without the leading "--".
+///==============================================================================
+void
+Data_t::processLongFlag(const std::string& cFlag){
+
+    const std::size_t equalPosition { cFlag.find(CHARACTER_equal) };
+    const std::string name          { cFlag.substr(0, equalPosition) };
+          char        parameter     { ' ' };
+
+    if (name == LONG_FLAG_STREAM && equalPosition == std::string::npos){
+       m_flagStream= true;
+       return;
+    }
+
+    if (name == LONG_FLAG_IN_PLACE && equalPosition == std::string::npos){
+       m_flagInPlace= true;
+       return;
+    }
+
+    if (name == LONG_FLAG_CRACK && equalPosition == std::string::npos){
+       m_flagCrack= true;
+       return;
+    }
+
+    if (name == LONG_FLAG_STATS && equalPosition == std::string::npos){
+       m_flagStats= true;
+       return;
+    }
+
+    if (name == LONG_FLAG_PERF && equalPosition == std::string::npos){
+       m_flagPerf= true;
+       return;
+    }
+
+    if (name == LONG_FLAG_BATCH)
+       m_flagBatch= true;
+    else if (name == LONG_FLAG_MIRROR)
+       m_flagMirror= true;
+    else if (name == LONG_FLAG_CRIB)
+       m_flagCrib= true;
+    else if (name == LONG_FLAG_BUILD_INDEX)
+       m_flagBuildIndex= true;
+    else if (name == LONG_FLAG_INDEX)
+       m_flagIndex= true;
+
+    if (name == LONG_FLAG_ISA)
+       parameter= PARAMETER_ISA;
+    else if (name == LONG_FLAG_THREADS)
+       parameter= PARAMETER_THREADS;
+    else if (name == LONG_FLAG_BUFFER_SIZE)
+       parameter= PARAMETER_BUFFER_SIZE;
+    else if (name == LONG_FLAG_BATCH)
+       parameter= PARAMETER_BATCH;
+    else if (name == LONG_FLAG_LIST)
+       parameter= PARAMETER_LIST;
+    else if (name == LONG_FLAG_MIRROR)
+       parameter= PARAMETER_MIRROR;
+    else if (name == LONG_FLAG_TOP)
+       parameter= PARAMETER_TOP;
+    else if (name == LONG_FLAG_SAMPLE)
+       parameter= PARAMETER_SAMPLE;
+    else if (name == LONG_FLAG_CRIB)
+       parameter= PARAMETER_CRIB;
+    else if (name == LONG_FLAG_BUILD_INDEX)
+       parameter= PARAMETER_BUILD_INDEX;
+    else if (name == LONG_FLAG_INDEX)
+       parameter= PARAMETER_INDEX;
+    else if (name == LONG_FLAG_TRACE)
+       parameter= PARAMETER_TRACE;
+    else
+       throw CaesarException_t(EXCEPTION_6);
+
+    if (equalPosition == std::string::npos){
+       m_nextParameters.emplace(parameter);
+       m_flagsWithParameters++;
+    }
+    else{
+       std::string value { cFlag.substr(equalPosition + 1) };
+
+       assignParameter(parameter, value);
+    }
+}
+
 ///==============================================================================
 /// @brief Validates whether the path exists and the file is a regular file.
 /// @param cPath Path where the file is located.
@@ -635,6 +1204,35 @@ Data_t::isAValidPath(const std::string& cPath) const noexcept{
     return isValid;
 }
 
+///==============================================================================
+/// @brief Validates whether the path exists and the file can be read as the
+///        input: a regular file, a pipe or a character device, such as
+///        /dev/stdin or a process substitution, but not a directory.
+/// @param cPath Path where the file is located.
+/// @return isValid is true whether the file can be the input.
+///==============================================================================
+bool
+Data_t::isAValidInputPath(const std::string& cPath) const noexcept{
+
+    bool            isValid { true };
+    std::error_code eCode;
+    //A link, such as /dev/stdin, is followed to the file it points to.
+    const std::filesystem::file_status status { std::filesystem::status(cPath, eCode) };
+
+    if (!std::filesystem::exists(status)){
+       isValid= false;
+       std::cout << "[+] No such file. Check if the current working directory has such a file or try it again with absolute path. \n";
+       std::cout << "[+] \n";
+    }
+    else if (!std::filesystem::is_regular_file(status) && !std::filesystem::is_fifo(status) && !std::filesystem::is_character_file(status)){
+       isValid= false;
+       std::cout << "[+] This isn't a regular file, a pipe or a character device. Must be one of them. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
 ///==============================================================================
 /// @brief Validates whether the language is English or Spanish.
 /// @param cLanguage The language selected.
@@ -656,6 +1254,74 @@ Data_t::isAValidLanguage(const std::string& cLanguage) const noexcept{
     return isValid;
 }
 
+///==============================================================================
+/// @brief Validates whether the output file can be written: it can be a new
+///        file, but not a directory.
+/// @param cPath Path of the output file.
+/// @return isValid is true whether the path can be an output file.
+///==============================================================================
+bool
+Data_t::isAValidOutputPath(const std::string& cPath) const noexcept{
+
+    bool            isValid { !cPath.empty() };
+    std::error_code eCode;
+
+    if (std::filesystem::is_directory(cPath, eCode)){
+       isValid= false;
+       std::cout << "[+] The output path is a directory. It must be a file. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Validates whether the path is an existing directory.
+/// @param cPath Path of the directory.
+/// @return isValid is true whether the path is a directory.
+///==============================================================================
+bool
+Data_t::isAValidDirectory(const std::string& cPath) const noexcept{
+
+    bool            isValid { true };
+    std::error_code eCode;
+
+    if (!std::filesystem::is_directory(cPath, eCode)){
+       isValid= false;
+       std::cout << "[+] No such directory. The directories of --batch and --mirror must exist. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Adds the files of a list to the batch, one path per line. The empty
+///        lines are skipped.
+/// @param cPath Path of the list.
+/// @return true whether the list could be read.
+///==============================================================================
+bool
+Data_t::loadBatchList(const std::string& cPath){
+
+    std::ifstream list { cPath };
+    std::string   line { "" };
+
+    if (!list.is_open())
+       return false;
+
+    while (std::getline(list, line)){
+       //Lists written on Windows end their lines with "\r\n".
+       if (!line.empty() && line.back() == '\r')
+          line.pop_back();
+
+       if (!line.empty())
+          m_batchPaths.push_back(line);
+    }
+
+    return !list.bad();
+}
+
 ///==============================================================================
 /// @brief Validates whether the selected level is valid.
 /// @param sLevel The level selected.
@@ -680,6 +1346,60 @@ Data_t::isAValidLevelValue(const std::string& sLevel) const{
     return isValid;
 }
 
+///==============================================================================
+/// @brief Validates a list of levels and ranges separated by commas, such as
+///        "3-7,12". A single level is a list of one element.
+/// @param sLevels The levels selected.
+/// @param levels Where the levels will be stored, sorted and without
+///        repetitions.
+/// @return isValid is true whether every level and range is valid.
+///==============================================================================
+bool
+Data_t::isAValidLevelList(const std::string& sLevels, std::vector<int>& levels) const{
+
+    bool        isValid { true };
+    std::size_t pivot   { 0 };
+
+    levels.clear();
+
+    while (isValid && pivot <= sLevels.length()){
+       std::size_t       comma { sLevels.find(CHARACTER_comma, pivot) };
+       const std::string item  { sLevels.substr(pivot, comma == std::string::npos ? std::string::npos : comma - pivot) };
+       //The dash of a range is never the first character, which can be the sign of a level.
+       const std::size_t dash  { item.find(CHARACTER_dash, 1) };
+
+       if (dash == std::string::npos){
+          isValid= isAValidLevelValue(item);
+
+          if (isValid)
+             levels.push_back(std::stoi(item));
+       }
+       else{
+          const std::string first { item.substr(0, dash) };
+          const std::string last  { item.substr(dash + 1) };
+
+          isValid= isAValidLevelValue(first) && isAValidLevelValue(last);
+
+          if (isValid && std::stoi(first) > std::stoi(last)){
+             isValid= false;
+             std::cout << "[+] Invalid range " << std::quoted(item) << ". It must go from the lowest level to the highest, like 3-7. \n";
+             std::cout << "[+] \n";
+          }
+
+          if (isValid)
+             for (int currentLevel= std::stoi(first); currentLevel <= std::stoi(last); currentLevel++)
+                levels.push_back(currentLevel);
+       }
+
+       pivot= (comma == std::string::npos) ? sLevels.length() + 1 : comma + 1;
+    }
+
+    std::sort(levels.begin(), levels.end());
+    levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+
+    return isValid && !levels.empty();
+}
+
 ///==============================================================================
 /// @brief Validates whether the string has a possible format to transform to 
 ///        integer.
@@ -712,58 +1432,201 @@ Data_t::canTransformToInteger(const std::string& sLevel) const noexcept{
 }
 
 ///==============================================================================
-/// @brief Loads data from a file.
-/// @param fileName Path where the file is located.
-/// @param data The file information will be stored.
+/// @brief Validates whether the instruction set is one of the known ones.
+/// @param sIsa Name of the instruction set.
+/// @return isValid is true whether the instruction set is known.
 ///==============================================================================
-void
-Data_t::loadDataFromFile(const std::string_view fileName, std::string& data){
+bool
+Data_t::isAValidIsa(const std::string& sIsa) const noexcept{
 
-    std::ifstream  inputFileStream { };
-    
-    //Open the input file.    
-    inputFileStream.open(fileName.data(), std::ios_base::in);
-    
-    if (inputFileStream.is_open()){
-       //Load the file in the string.
-       std::string buffer { std::istreambuf_iterator<char> { inputFileStream }, std::istreambuf_iterator<char> { } };
+    bool isValid { getIsaFromName(sIsa) != automaticIsa };
+
+    if (!isValid){
+       std::cout << "[+] The instruction set entered is not correct. It must be " << std::quoted(ISA_SCALAR.data()) << ", " << std::quoted(ISA_SSE2.data());
+       std::cout << ", " << std::quoted(ISA_AVX2.data()) << " or " << std::quoted(ISA_AVX512.data()) << ". \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Validates whether the number of threads is valid.
+/// @param sThreads The number of threads selected.
+/// @return isValid is true whether the number of threads is valid.
+///==============================================================================
+bool
+Data_t::isAValidThreads(const std::string& sThreads) const{
+
+    bool isValid { false };
+
+    if (sThreads.length() > 0 && canTransformToInteger(sThreads)){
+       int threads { std::stoi(sThreads) };
+
+       if (threads >= MIN_THREADS && threads <= MAX_THREADS)
+          isValid= true;
+       else{
+          std::cout << "[+] Invalid number of threads. You must enter a number between " << MIN_THREADS << " and " << MAX_THREADS << ". Including both. \n";
+          std::cout << "[+] \n";
+       }
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Validates whether the size of the blocks is valid.
+/// @param sSize The size selected, in bytes or with the suffix K or M.
+/// @return isValid is true whether the size is valid.
+///==============================================================================
+bool
+Data_t::isAValidBufferSize(const std::string& sSize) const{
+
+    const std::size_t size    { getSizeFromText(sSize) };
+          bool        isValid { size >= MIN_BUFFER_SIZE && size <= MAX_BUFFER_SIZE };
+
+    if (!isValid){
+       std::cout << "[+] Invalid buffer size. You must enter a size between " << MIN_BUFFER_SIZE / 1024 << "K and " << MAX_BUFFER_SIZE / (1024 * 1024) << "M. Including both. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Gets a size from its text: a number of bytes followed by nothing or
+///        by the suffix K (kibibytes) or M (mebibytes).
+/// @param sSize Text of the size.
+/// @return The size in bytes, or 0 if the text isn't valid.
+///==============================================================================
+std::size_t
+Data_t::getSizeFromText(const std::string& sSize) const noexcept{
+
+    std::size_t size  { 0 };
+    std::size_t pivot { 0 };
 
-       data= std::move(buffer);
+    //Up to 10 digits, so the size in mebibytes can't overflow.
+    while (pivot < sSize.length() && pivot < 10 && std::isdigit(static_cast<unsigned char>(sSize[pivot]))){
+       size= size * 10 + (sSize[pivot] - '0');
+       pivot++;
+    }
+
+    if (pivot == 0)
+       return 0;
 
-       inputFileStream.close();
+    if (pivot + 1 == sSize.length()){
+       const char suffix { static_cast<char>(std::tolower(static_cast<unsigned char>(sSize[pivot]))) };
+
+       if (suffix == CHARACTER_K)
+          size*= 1024;
+       else if (suffix == CHARACTER_M)
+          size*= 1024 * 1024;
+       else
+          return 0;
     }
+    else if (pivot != sSize.length())
+       return 0;
+
+    return size;
+}
+
+///==============================================================================
+/// @brief Validates whether the number of levels written by --crack is valid.
+/// @param sTop The number selected.
+/// @return isValid is true whether the number is valid.
+///==============================================================================
+bool
+Data_t::isAValidTop(const std::string& sTop) const{
+
+    bool isValid { false };
+
+    if (sTop.length() > 0 && sTop.length() <= 2 && canTransformToInteger(sTop)){
+       int top { std::stoi(sTop) };
+
+       if (top >= MIN_LEVEL && top <= MAX_LEVEL_ENGLISH + MAX_LEVEL_SPANISH)
+          isValid= true;
+    }
+
+    if (!isValid){
+       std::cout << "[+] Invalid number of levels. You must enter a number between " << MIN_LEVEL << " and " << MAX_LEVEL_ENGLISH + MAX_LEVEL_SPANISH << ". Including both. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Validates whether the size of the sample of --crack is valid.
+/// @param sSize The size selected, in bytes or with the suffix K or M.
+/// @return isValid is true whether the size is valid.
+///==============================================================================
+bool
+Data_t::isAValidSampleSize(const std::string& sSize) const{
+
+    const std::size_t size    { getSizeFromText(sSize) };
+          bool        isValid { size >= MIN_SAMPLE_SIZE && size <= MAX_SAMPLE_SIZE };
+
+    if (!isValid){
+       std::cout << "[+] Invalid sample size. You must enter a size between " << MIN_SAMPLE_SIZE / 1024 << "K and " << MAX_SAMPLE_SIZE / (1024 * 1024) << "M. Including both. \n";
+       std::cout << "[+] \n";
+    }
+
+    return isValid;
+}
+
+///==============================================================================
+/// @brief Gets the instruction set from its name.
+/// @param sIsa Name of the instruction set.
+/// @return The instruction set, or automaticIsa if the name is unknown.
+///==============================================================================
+Isa_t
+Data_t::getIsaFromName(const std::string& sIsa) const noexcept{
+
+    if (sIsa == ISA_SCALAR.data())
+       return scalarIsa;
+    else if (sIsa == ISA_SSE2.data())
+       return sse2Isa;
+    else if (sIsa == ISA_AVX2.data())
+       return avx2Isa;
+    else if (sIsa == ISA_AVX512.data())
+       return avx512Isa;
     else
-       throw CaesarException_t(EXCEPTION_3);
+       return automaticIsa;
+}
+
+///==============================================================================
+/// @brief Loads data from a file. The file is mapped in memory instead of
+///        copied, or read if it can't be mapped.
+/// @param fileName Path where the file is located.
+///==============================================================================
+void
+Data_t::loadDataFromFile(const std::string& fileName){
+
+    CAESAR_PROBE1(file_open, fileName.c_str());
+    m_inputFile.emplace(fileName);
+    CAESAR_PROBE2(file_read, fileName.c_str(), m_inputFile->getContent().size());
 }
 
 ///==============================================================================
 /// @brief Searches for the current character's data in the alphabet.
 /// @param c Character to search.
+/// @param codePoint Code point of the character.
 /// @param dC The searched information will be stored.
-/// @param alphabet String containing all the characters of the selected 
-///        language.
+/// @param alphabet Alphabet of the selected language.
 /// @param type Indicates the type of characters in the alphabet: lowercase or 
 ///        uppercase.
 /// @return true whether the current character is found in the alphabet.
 ///==============================================================================
 bool
-Data_t::searchCharacter(const std::string& c, DataCharacter_t& dC, const std::string& alphabet, const TypeCharacter_t type) const noexcept{
+Data_t::searchCharacter(const std::string& c, const char32_t codePoint, DataCharacter_t& dC, const Alphabet_t& alphabet, const TypeCharacter_t type) const noexcept{
 
-                 bool found  { false };
-    long unsigned int pivot  { 0 };
+    const int  position { alphabet.find(codePoint) };
+    const bool found    { position >= 0 };
 
-    while ((!found) && (pivot < alphabet.length())){
-               int      length { getUTF8CharLength(static_cast<unsigned char>(alphabet[pivot])) };
-       std::string currentChar { alphabet.substr(pivot, length) };
-       
-       if (c == currentChar){
-          dC.character= c;
-          dC.type= type;
-          dC.position= pivot;
-          found= true;
-       }
-        else
-           pivot+= length;
+    if (found){
+       dC.character= c;
+       dC.type= type;
+       dC.position= position;
     }
     
     return found;
@@ -778,37 +1641,7 @@ Data_t::searchCharacter(const std::string& c, DataCharacter_t& dC, const std::st
 int 
 Data_t::getUTF8CharLength(unsigned char byte) const noexcept{
     
-    if ((byte & 0x80) == 0x00)      // 0xxxxxxx - One-byte character.
-       return 1;
-    else if ((byte & 0xE0) == 0xC0) // 110xxxxx - Two-byte character.
-       return 2;
-    else if ((byte & 0xF0) == 0xE0) // 1110xxxx - Three-byte character.
-       return 3;
-    else if ((byte & 0xF8) == 0xF0) // 11110xxx - Four-byte character.
-       return 4;
-    else                            // Not valid.
-       return -1;
-
-}
-
-///==============================================================================
-/// @brief Gets the next position to validate when descrypting.
-/// @param initialPosition Current character position in the alphabet.
-/// @param alphabet String containing all the characters of the selected 
-///        language. 
-/// @return The next position to validate.
-///==============================================================================
-int
-Data_t::nextDecryptPosition(const int initialPosition, const std::string& alphabet) const noexcept{
-
-    int currentPosition { initialPosition };
-    
-    if (currentPosition == 0)
-       currentPosition= alphabet.length() - 1;
-    else
-       currentPosition--;
-    
-    return currentPosition;
+    return utf8Length(byte);
 }
 
 } // namespace SherpadCaesar
@@ -1,8 +1,13 @@
 // SPDX-License-Identifier: GPL-v3.0
 #pragma once
 
+#include <optional>
 #include <queue>
 #include <string>
+#include <string_view>
+#include <vector>
+#include "alpha/alphabet.hpp"
+#include "../io/mappedFile.hpp"
 #include "utils/utils.hpp"
 
 namespace SherpadCaesar{
@@ -46,18 +51,33 @@ class Arguments_t;
                                                               /// @brief Indicates whether the user wants to transform in a specific level or not.
                                                        bool   m_flagLevel           { false };
 
+                                                              /// @brief Indicates whether the user wants to write the result in a file or not.
+                                                       bool   m_flagOutput          { false };
+
+                                                              /// @brief Indicates whether the user wants to rewrite the input file with the result or not.
+                                                       bool   m_flagInPlace         { false };
+
                                                               /// @brief Contains the text to be transformed.
                                                 std::string   m_data                { "" };
 
+                                                              /// @brief Contains the file to be transformed once it is loaded. It is mapped in memory instead of copied to m_data.
+                                 std::optional<MappedFile_t>  m_inputFile           { };
+
                                                               /// @brief Contains the path of the text to be transformed if it comes from a file.
                                                 std::string   m_path                { "" };
 
+                                                              /// @brief Contains the path of the file where the result is written. If it is empty, it is written in the standard output.
+                                                std::string   m_outputPath          { "" };
+
                                                               /// @brief Contains the language of the text to be transformed. If not specified, it will default to English. 
                                                 std::string   m_language            { "" };
 
                                                               /// @brief Contains the specific level at which to perform the transformation. If it is 0, a bulk transformation will be performed.
                                                         int   m_level               { 0 };
 
+                                                              /// @brief Contains the levels selected with a list or a range (e.g. "3-7,12"), sorted and without repetitions. Empty if there is only one level.
+                                           std::vector<int>   m_levels              { };
+
                                                               /// @brief Contains the minimum level to transform the message. It will always be 1.
                                       const             int   m_minLevel            { MIN_LEVEL };
 
@@ -68,22 +88,98 @@ class Arguments_t;
                                             std::queue<char>  m_nextParameters      { };
 
                                                               /// @brief Alphabet in uppercase letters. English alphabet by default.
-                                                std::string   m_alphabetUppercase   { englishUppercaseAlphabet.data() };
+                                                 Alphabet_t   m_alphabetUppercase   { englishUppercaseAlphabet };
 
                                                               /// @brief Alphabet in lowercase letters. English alphabet by default.
-                                                std::string   m_alphabetLowercase   { englishLowercaseAlphabet.data() };
+                                                 Alphabet_t   m_alphabetLowercase   { englishLowercaseAlphabet };
                                                 
                                                               /// @brief Contains the number of flags that require parameters.
                                                         int   m_flagsWithParameters { 0 };
 
+                                                              /// @brief Instruction set forced by the user for the ASCII kernels. By default the widest one supported is used.
+                                                      Isa_t   m_isa                 { automaticIsa };
+
+                                                              /// @brief Number of threads chosen by the user. If it is 0, one per hardware thread is used.
+                                                std::size_t   m_threads             { 0 };
+
+                                                              /// @brief Indicates whether the user wants to transform a file in blocks instead of loading it whole.
+                                                       bool   m_flagStream          { false };
+
+                                                              /// @brief Size of the blocks read from the file in streaming mode.
+                                                std::size_t   m_bufferSize          { DEFAULT_BUFFER_SIZE };
+
+                                                              /// @brief Indicates whether the user wants to transform many files at once.
+                                                       bool   m_flagBatch           { false };
+
+                                                              /// @brief Contains the directory where the files of the batch are written.
+                                                std::string   m_batchDirectory      { "" };
+
+                                                              /// @brief Contains the paths of the files of the batch, from the arguments and the list files.
+                                   std::vector<std::string>   m_batchPaths          { };
+
+                                                              /// @brief Indicates whether the user wants to mirror a directory tree into the directory of the batch.
+                                                       bool   m_flagMirror          { false };
+
+                                                              /// @brief Contains the source directory of the mirror.
+                                                std::string   m_mirrorDirectory     { "" };
+
+                                                              /// @brief Indicates whether the user wants the levels that most likely decrypt the input instead of all of them.
+                                                       bool   m_flagCrack           { false };
+
+                                                              /// @brief Number of the most likely levels written by --crack.
+                                                        int   m_top                 { 1 };
+
+                                                              /// @brief Bytes at the start of the input analyzed by --crack. If it is 0, the whole input is analyzed.
+                                                std::size_t   m_sampleSize          { 0 };
+
+                                                              /// @brief Indicates whether the user wants the levels at which a known piece of the plaintext appears in the input.
+                                                       bool   m_flagCrib            { false };
+
+                                                              /// @brief Contains the known piece of the plaintext searched by --crib.
+                                                std::string   m_crib                { "" };
+
+                                                              /// @brief Indicates whether the user wants to build an index of the files to search cribs in them later.
+                                                       bool   m_flagBuildIndex      { false };
+
+                                                              /// @brief Indicates whether the user wants to search the crib in the files of an index.
+                                                       bool   m_flagIndex           { false };
+
+                                                              /// @brief Contains the path of the index that is built or searched.
+                                                std::string   m_indexPath           { "" };
+
+                                                              /// @brief Indicates whether the user wants a summary of the run on the standard error.
+                                                       bool   m_flagStats           { false };
+
+                                                              /// @brief Indicates whether the user wants the hardware counters of every stage of the transformation.
+                                                       bool   m_flagPerf            { false };
+
+                                                              /// @brief Contains the path of the timeline written by --trace. Empty if it isn't written.
+                                                std::string   m_tracePath           { "" };
+
+                                                              /// @brief Time spent interpreting the arguments, in seconds.
+                                                     double   m_parsingTime         { 0.0 };
+
                                                        void   processArgument(std::string&);
+                                                       void   processLongFlag(const std::string&);
+                                                       bool   assignParameter(const char, std::string&);
                                                        bool   isAValidPath(const std::string&)                                                                         const noexcept;
+                                                       bool   isAValidInputPath(const std::string&)                                                                    const noexcept;
                                                        bool   isAValidLanguage(const std::string&)                                                                     const noexcept;
+                                                       bool   isAValidOutputPath(const std::string&)                                                                   const noexcept;
+                                                       bool   isAValidDirectory(const std::string&)                                                                    const noexcept;
+                                                       bool   loadBatchList(const std::string&);
                                                        bool   isAValidLevelValue(const std::string&)                                                                   const;
+                                                       bool   isAValidLevelList(const std::string&, std::vector<int>&)                                                 const;
                                                        bool   canTransformToInteger(const std::string&)                                                                const noexcept;
-                                                       void   loadDataFromFile(const std::string_view, std::string&);
-                                                       bool   searchCharacter(const std::string&, DataCharacter_t&, const std::string&, const TypeCharacter_t)         const noexcept;
-                                                        int   nextDecryptPosition(const int, const std::string&)                                                       const noexcept;
+                                                       bool   isAValidIsa(const std::string&)                                                                          const noexcept;
+                                                       bool   isAValidThreads(const std::string&)                                                                      const;
+                                                       bool   isAValidBufferSize(const std::string&)                                                                   const;
+                                                       bool   isAValidTop(const std::string&)                                                                          const;
+                                                       bool   isAValidSampleSize(const std::string&)                                                                   const;
+                                                std::size_t   getSizeFromText(const std::string&)                                                                      const noexcept;
+                                                      Isa_t   getIsaFromName(const std::string&)                                                                       const noexcept;
+                                                       void   loadDataFromFile(const std::string&);
+                                                       bool   searchCharacter(const std::string&, const char32_t, DataCharacter_t&, const Alphabet_t&, const TypeCharacter_t) const noexcept;
 
         public:
                 explicit                                      Data_t(Arguments_t&);
@@ -97,6 +193,7 @@ class Arguments_t;
                                                        void   initLanguage()                                                                                                    noexcept;
                                                        void   initLevel()                                                                                                       noexcept;
                                                        bool   assignInformation(std::string&);
+                                                       void   loadData();
                                                        bool   needDisplayHelp()                                                                                           const noexcept;
                                                        bool   needDisplayInformation()                                                                                    const noexcept;
                                                        bool   needDisplayWarranty()                                                                                       const noexcept;
@@ -105,32 +202,66 @@ class Arguments_t;
                                                        bool   wantDecrypt()                                                                                               const noexcept;
                                                        bool   isFromString()                                                                                              const noexcept;
                                                        bool   isFromFile()                                                                                                const noexcept;
+                                                       bool   isFromStandardInput()                                                                                       const noexcept;
+                                                       bool   isReadOnce()                                                                                                const noexcept;
                                                        bool   isEnglishLanguage()                                                                                         const noexcept;
                                                        bool   isSpanishLanguage()                                                                                         const noexcept;
                                                        bool   isBulk()                                                                                                    const noexcept;
                                                        bool   isSpecific()                                                                                                const noexcept;
+                                                       bool   isMultiLevel()                                                                                              const noexcept;
+                                                       bool   isStreaming()                                                                                               const noexcept;
+                                                       bool   hasOutputFile()                                                                                             const noexcept;
+                                                       bool   isInPlace()                                                                                                 const noexcept;
+                                                       bool   isBatch()                                                                                                   const noexcept;
+                                                       bool   isMirror()                                                                                                  const noexcept;
+                                                       bool   isCrack()                                                                                                   const noexcept;
+                                                       bool   isCrib()                                                                                                    const noexcept;
+                                                       bool   isIndexBuild()                                                                                              const noexcept;
+                                                       bool   isIndexSearch()                                                                                             const noexcept;
+                                                       bool   isStats()                                                                                                   const noexcept;
+                                                       bool   isPerf()                                                                                                    const noexcept;
+                                                       bool   isTrace()                                                                                                   const noexcept;
+                                                       bool   isLanguageSelected()                                                                                        const noexcept;
                                                        void   setFlagEncrypt(const bool)                                                                                        noexcept;
                                                        void   setFlagDecrypt(const bool)                                                                                        noexcept;
                                                        void   setFlagString(const bool)                                                                                         noexcept;
                                                        void   setFlagFile(const bool)                                                                                           noexcept;
                                                        void   setFlagLanguage(const bool)                                                                                       noexcept;
+                                                       void   setLanguage(const Language_t);
                                                        void   setFlagLevel(const bool)                                                                                          noexcept;
                                                        void   pushNextParameter(const char)                                                                                     noexcept;
                                           const         int   getLevel()                                                                                                  const noexcept;
                                           const         int   getMinLevel()                                                                                               const noexcept;
                                           const         int   getMaxLevel()                                                                                               const noexcept;
-                                          const std::string&  getData()                                                                                                   const noexcept;
-                                          const std::string&  getAlphabetUppercase()                                                                                      const noexcept;
-                                          const std::string&  getAlphabetLowercase()                                                                                      const noexcept;
+                                           std::vector<int>   getLevels()                                                                                                 const;
+                                           std::string_view   getData()                                                                                                   const noexcept;
+                                                      Isa_t   getIsa()                                                                                                    const noexcept;
+                                                std::size_t   getThreads()                                                                                                const noexcept;
+                                                std::size_t   getBufferSize()                                                                                             const noexcept;
+                                                        int   getTop()                                                                                                    const noexcept;
+                                                std::size_t   getSampleSize()                                                                                             const noexcept;
+                                          const std::string&  getPath()                                                                                                   const noexcept;
+                                          const std::string&  getOutputPath()                                                                                             const noexcept;
+                                          const std::string&  getBatchDirectory()                                                                                         const noexcept;
+                                          const std::string&  getMirrorDirectory()                                                                                        const noexcept;
+                                          const std::string&  getCrib()                                                                                                   const noexcept;
+                                          const std::string&  getIndexPath()                                                                                              const noexcept;
+                                          const std::string&  getTracePath()                                                                                              const noexcept;
+                                                     double   getParsingTime()                                                                                            const noexcept;
+                            const std::vector<std::string>&   getBatchPaths()                                                                                             const noexcept;
+                                                 Language_t   getLanguage()                                                                                               const noexcept;
+                                                Direction_t   getDirection()                                                                                              const noexcept;
+                                           const Alphabet_t&  getAlphabetUppercase()                                                                                      const noexcept;
+                                           const Alphabet_t&  getAlphabetLowercase()                                                                                      const noexcept;
                                                        bool   findCharacterData(const std::string&, DataCharacter_t&)                                                     const noexcept;
                                                 std::string   getCharacter(const std::string&, const int)                                                                 const noexcept;
-                                                       void   loadOtherAlphabet()                                                                                               noexcept;
-                                                       void   loadNewAlphabet(const std::string_view, const std::string_view, const int)                                        noexcept;
-                                                std::string   getTransformedCharacter(const std::string&, const int, const int)                                           const noexcept;
-                                                std::string   transformEnglishCharacter(const std::string&, const int)                                                    const noexcept;
-                                                std::string   transformOtherLanguageCharacter(const std::string&, const int, const int)                                   const noexcept;
-                                                std::string   getEncryptedCharacter(const std::string&, const int, const int)                                             const noexcept;
-                                                std::string   getDecryptedCharacter(const std::string&, const int, const int)                                             const noexcept;
+                                                       void   loadOtherAlphabet();
+                                                       void   loadNewAlphabet(const std::string_view, const std::string_view, const int);
+                                                std::string   getTransformedCharacter(const Alphabet_t&, const int, const int)                                            const noexcept;
+                                                std::string   transformEnglishCharacter(const Alphabet_t&, const int)                                                     const noexcept;
+                                                std::string   transformOtherLanguageCharacter(const Alphabet_t&, const int, const int)                                    const noexcept;
+                                                std::string   getEncryptedCharacter(const Alphabet_t&, const int, const int)                                              const noexcept;
+                                                std::string   getDecryptedCharacter(const Alphabet_t&, const int, const int)                                              const noexcept;
                                                         int   getUTF8CharLength(unsigned char)                                                                            const noexcept;
                                                        
     };
@@ -21,7 +21,7 @@ CaesarException_t::what() const noexcept{
 
    switch(m_reason) {
       case 0:
-         return "[-] FATAL ERROR!!! Exception caught: There is a flag that isn't correct. Correct flags: h, i, w, c, e, d, k, s, f and l.\n";
+         return "[-] FATAL ERROR!!! Exception caught: There is a flag that isn't correct. Correct flags: h, i, w, c, e, d, k, s, f, l and o.\n";
       case 1:
          return "[-] FATAL ERROR!!! Exception caught: Value without flag. Please, remember to write the flags before writting the values.\n";
       case 2:
@@ -32,6 +32,48 @@ CaesarException_t::what() const noexcept{
          return "[-] FATAL ERROR!!! Exception caught: The language must be selected before the string/file and level. Please rewrite the command correctly. \n";
       case 5:
          return "[-] FATAL ERROR!!! Exception caught: The number of flags that require parameters and the number of parameters are diferent. \n";
+      case 6:
+         return "[-] FATAL ERROR!!! Exception caught: There is a long flag that isn't correct. Type 'caesar -h' to see the correct flags.\n";
+      case 7:
+         return "[-] FATAL ERROR!!! Exception caught: Error reading input file.\n";
+      case 8:
+         return "[-] FATAL ERROR!!! Exception caught: Error writing the output.\n";
+      case 9:
+         return "[-] FATAL ERROR!!! Exception caught: Error opening output file.\n";
+      case 10:
+         return "[-] FATAL ERROR!!! Exception caught: The output file is the input file. Use --in-place to rewrite the input file. \n";
+      case 11:
+         return "[-] FATAL ERROR!!! Exception caught: --in-place needs a regular file (-f), not the standard input or a pipe, a specific level (-l) and no output file (-o). \n";
+      case 12:
+         return "[-] FATAL ERROR!!! Exception caught: The transformation changes the size of the file, so it can't be rewritten in place. The file hasn't been modified. \n";
+      case 13:
+         return "[-] FATAL ERROR!!! Exception caught: --batch needs a directory, a specific level (-l) and the files to transform, and can't be used with -s, -f, -o or --in-place. \n";
+      case 14:
+         return "[-] FATAL ERROR!!! Exception caught: Error in the asynchronous input/output. \n";
+      case 15:
+         return "[-] FATAL ERROR!!! Exception caught: --mirror needs a source directory, the output directory (--batch) and a specific level (-l), and can't be used with files, -s, -f, -o or --in-place. \n";
+      case 16:
+         return "[-] FATAL ERROR!!! Exception caught: Error reading the source directory of the mirror. No file has been transformed. \n";
+      case 17:
+         return "[-] FATAL ERROR!!! Exception caught: Error writing the manifest of the mirror. The next run will transform every file again. \n";
+      case 18:
+         return "[-] FATAL ERROR!!! Exception caught: --crack decrypts a file (-f) or a string (-s) without a level (-l), and can't be used with -e, --in-place, --batch or --mirror. \n";
+      case 19:
+         return "[-] FATAL ERROR!!! Exception caught: There are no letters to analyze with --crack. \n";
+      case 20:
+         return "[-] FATAL ERROR!!! Exception caught: --crib searches a file (-f), a string (-s) or the files of an index (--index) without a level (-l), and can't be used with -e, -o, --crack, --in-place, --batch or --mirror. \n";
+      case 21:
+         return "[-] FATAL ERROR!!! Exception caught: The crib needs at least two letters of the alphabet. \n";
+      case 22:
+         return "[-] FATAL ERROR!!! Exception caught: --build-index needs the files to index, and can't be used with -s, -f, -l, -o, --in-place, --batch, --mirror, --crack, --crib or --index. \n";
+      case 23:
+         return "[-] FATAL ERROR!!! Exception caught: The index is damaged or was written by another version of the program. Build it again. \n";
+      case 24:
+         return "[-] FATAL ERROR!!! Exception caught: Error writing the index. \n";
+      case 25:
+         return "[-] FATAL ERROR!!! Exception caught: An engine needs English or Spanish, a direction and a level between 1 and the number of letters of the alphabet minus one. \n";
+      case 26:
+         return "[-] FATAL ERROR!!! Exception caught: Error writing the trace. The output was written. \n";
       default:
          return "[-] FATAL ERROR!!! Exception not covered.\n";
    }
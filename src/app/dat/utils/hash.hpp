@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SherpadCaesar{
+
+/// @brief Initial value of the 64-bit FNV-1a hash. It is also the hash of an empty content.
+constexpr std::uint64_t FNV1A_OFFSET_BASIS { 0xCBF29CE484222325ULL };
+
+/// @brief Multiplier of the 64-bit FNV-1a hash.
+constexpr std::uint64_t FNV1A_PRIME        { 0x00000100000001B3ULL };
+
+///==============================================================================
+/// @brief Calculates the 64-bit FNV-1a hash of some bytes. A content split in
+///        several pieces is hashed by passing the hash of the previous piece.
+/// @param bytes Bytes to hash.
+/// @param size Number of bytes.
+/// @param hash Hash of the previous bytes.
+/// @return The hash of the bytes.
+///==============================================================================
+constexpr std::uint64_t
+fnv1a(const char* bytes, const std::size_t size, std::uint64_t hash= FNV1A_OFFSET_BASIS) noexcept{
+
+    for (std::size_t i= 0; i < size; i++){
+       hash^= static_cast<unsigned char>(bytes[i]);
+       hash*= FNV1A_PRIME;
+    }
+
+    return hash;
+}
+
+} // namespace SherpadCaesar
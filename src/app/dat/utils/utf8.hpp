@@ -0,0 +1,230 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace SherpadCaesar{
+
+/// @brief Biggest number of bytes of a UTF-8 character.
+constexpr          int UTF8_MAX_LENGTH { 4 };
+
+/// @brief First value given by decodeUTF8Character to the bytes that don't start a valid character, beyond Unicode.
+constexpr     char32_t UTF8_INVALID_BASE { 0x110000 };
+
+///==============================================================================
+/// @brief Calculates the size of a UTF-8 character in bytes from its first byte.
+/// @param byte First byte of the character.
+/// @return The size of the character in bytes, or -1 if the byte can't start a
+///         UTF-8 character.
+///==============================================================================
+constexpr int
+utf8Length(const unsigned char byte) noexcept{
+
+    if ((byte & 0x80) == 0x00)      // 0xxxxxxx - One-byte character.
+       return 1;
+    else if ((byte & 0xE0) == 0xC0) // 110xxxxx - Two-byte character.
+       return 2;
+    else if ((byte & 0xF0) == 0xE0) // 1110xxxx - Three-byte character.
+       return 3;
+    else if ((byte & 0xF8) == 0xF0) // 11110xxx - Four-byte character.
+       return 4;
+    else                            // Not valid.
+       return -1;
+}
+
+///==============================================================================
+/// @brief Indicates whether a byte is a UTF-8 continuation byte (10xxxxxx).
+/// @param byte Byte to validate.
+/// @return true whether the byte continues a multi-byte character.
+///==============================================================================
+constexpr bool
+isUTF8Continuation(const unsigned char byte) noexcept{
+
+    return (byte & 0xC0) == 0x80;
+}
+
+///==============================================================================
+/// @brief Decodes a UTF-8 character whose length is already known.
+/// @param bytes First byte of the character.
+/// @param length Size of the character in bytes (1 to 4).
+/// @return The code point, or -1 if the continuation bytes are not valid.
+///==============================================================================
+constexpr long
+decodeUTF8(const char* bytes, const int length) noexcept{
+
+    constexpr unsigned char leadMask[] { 0x00, 0x7F, 0x1F, 0x0F, 0x07 };
+
+    long codePoint { static_cast<unsigned char>(bytes[0]) & leadMask[length] };
+
+    for (int i= 1; i < length; i++){
+       const unsigned char byte { static_cast<unsigned char>(bytes[i]) };
+
+       if (!isUTF8Continuation(byte))
+          return -1;
+
+       codePoint= (codePoint << 6) | (byte & 0x3F);
+    }
+
+    return codePoint;
+}
+
+///==============================================================================
+/// @brief Encodes a code point in UTF-8.
+/// @param codePoint Code point to encode.
+/// @param bytes Where the encoded character will be stored. It needs room for
+///        UTF8_MAX_LENGTH bytes.
+/// @return The number of bytes written.
+///==============================================================================
+constexpr int
+encodeUTF8(const char32_t codePoint, char* bytes) noexcept{
+
+    if (codePoint < 0x80){
+       bytes[0]= static_cast<char>(codePoint);
+       return 1;
+    }
+    else if (codePoint < 0x800){
+       bytes[0]= static_cast<char>(0xC0 | (codePoint >> 6));
+       bytes[1]= static_cast<char>(0x80 | (codePoint & 0x3F));
+       return 2;
+    }
+    else if (codePoint < 0x10000){
+       bytes[0]= static_cast<char>(0xE0 | (codePoint >> 12));
+       bytes[1]= static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+       bytes[2]= static_cast<char>(0x80 | (codePoint & 0x3F));
+       return 3;
+    }
+    else{
+       bytes[0]= static_cast<char>(0xF0 | (codePoint >> 18));
+       bytes[1]= static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+       bytes[2]= static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+       bytes[3]= static_cast<char>(0x80 | (codePoint & 0x3F));
+       return 4;
+    }
+}
+
+///==============================================================================
+/// @brief Finds the start of the character that contains a position, so that a
+///        text can be split there without cutting a character in half.
+/// @param text Text to split.
+/// @param length Size of the text in bytes.
+/// @param position Position where the text would be split.
+/// @return The nearest position at or before the given one where a character
+///         starts. Invalid bytes are taken as characters on their own.
+///==============================================================================
+constexpr std::size_t
+findUTF8Boundary(const char* text, const std::size_t length, const std::size_t position) noexcept{
+
+    std::size_t boundary { position };
+
+    if (boundary >= length)
+       return length;
+
+    while (boundary > 0 && position - boundary < UTF8_MAX_LENGTH - 1 && isUTF8Continuation(static_cast<unsigned char>(text[boundary])))
+       boundary--;
+
+    return isUTF8Continuation(static_cast<unsigned char>(text[boundary])) ? position : boundary;
+}
+
+///==============================================================================
+/// @brief Finds how many bytes at the start of a block end with a whole
+///        character, so the bytes of a character cut at the end of the block
+///        can be carried over to the next one.
+/// @param text Block of a text.
+/// @param length Size of the block in bytes.
+/// @return The size of the block without the last character if it is cut.
+///==============================================================================
+constexpr std::size_t
+getCompleteUTF8Length(const char* text, const std::size_t length) noexcept{
+
+    if (length == 0)
+       return 0;
+
+    const std::size_t lastStart  { findUTF8Boundary(text, length, length - 1) };
+    const int         lastLength { utf8Length(static_cast<unsigned char>(text[lastStart])) };
+
+    return (lastLength > 0 && lastStart + lastLength > length) ? lastStart : length;
+}
+
+///==============================================================================
+/// @brief Decodes the character that starts at a position of a text. A byte
+///        that doesn't start a valid character is taken as a character on its
+///        own, whose value is UTF8_INVALID_BASE plus the byte, so it is still
+///        told apart from the others.
+/// @param text Text to decode.
+/// @param length Size of the text in bytes.
+/// @param position Position of the first byte of the character.
+/// @param codePoint Where the code point is stored.
+/// @return The size of the character in bytes.
+///==============================================================================
+constexpr int
+decodeUTF8Character(const char* text, const std::size_t length, const std::size_t position, char32_t& codePoint) noexcept{
+
+    const unsigned char byte           { static_cast<unsigned char>(text[position]) };
+    const int           characterLength{ utf8Length(byte) };
+
+    if (characterLength == 1){
+       codePoint= byte;
+       return 1;
+    }
+
+    if (characterLength > 1 && position + static_cast<std::size_t>(characterLength) <= length){
+       const long decoded { decodeUTF8(text + position, characterLength) };
+
+       if (decoded >= 0){
+          codePoint= static_cast<char32_t>(decoded);
+          return characterLength;
+       }
+    }
+
+    codePoint= UTF8_INVALID_BASE + byte;
+
+    return 1;
+}
+
+///==============================================================================
+/// @brief Counts the characters of a UTF-8 text. It can be evaluated at
+///        compile time.
+/// @param text Valid UTF-8 text.
+/// @return The number of characters.
+///==============================================================================
+constexpr std::size_t
+countUTF8Characters(const std::string_view text) noexcept{
+
+    std::size_t count { 0 };
+    std::size_t pivot { 0 };
+
+    while (pivot < text.length()){
+       pivot+= utf8Length(static_cast<unsigned char>(text[pivot]));
+       count++;
+    }
+
+    return count;
+}
+
+///==============================================================================
+/// @brief Decodes a UTF-8 text in code points. It can be evaluated at compile
+///        time.
+/// @tparam N Number of characters of the text, see countUTF8Characters.
+/// @param text Valid UTF-8 text.
+/// @return The code point of every character.
+///==============================================================================
+template <std::size_t N>
+constexpr std::array<char32_t, N>
+decodeUTF8Text(const std::string_view text) noexcept{
+
+    std::array<char32_t, N> codePoints { };
+    std::size_t             pivot      { 0 };
+
+    for (std::size_t i= 0; i < N; i++){
+       const int length { utf8Length(static_cast<unsigned char>(text[pivot])) };
+
+       codePoints[i]= static_cast<char32_t>(decodeUTF8(text.data() + pivot, length));
+       pivot+= length;
+    }
+
+    return codePoints;
+}
+
+} // SherpadCaesar
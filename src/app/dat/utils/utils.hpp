@@ -1,13 +1,24 @@
 // SPDX-License-Identifier: GPL-v3.0
 #pragma once
 
+#include <string>
 #include <string_view>
+#include "utf8.hpp"
 
 namespace SherpadCaesar{
 
 /// @brief Indicates the type of character.
 enum TypeCharacter_t {capitalLetter, smallLetter, other};
 
+/// @brief Languages whose alphabets are known at compile time.
+enum Language_t {englishLanguage, spanishLanguage};
+
+/// @brief Direction of the transformation.
+enum Direction_t {encryptDirection, decryptDirection};
+
+/// @brief Instruction sets of the ASCII kernels, from the narrowest to the widest. automaticIsa selects the widest supported.
+enum Isa_t {automaticIsa, scalarIsa, sse2Isa, avx2Isa, avx512Isa};
+
 /// @brief Structure that stores the information of the selected character.
 struct DataCharacter_t {
                       /// @brief character Selected character.
@@ -39,6 +50,46 @@ constexpr         char CHARACTER_s    { 's' };
 constexpr         char CHARACTER_f    { 'f' };
 constexpr         char CHARACTER_k    { 'k' };
 constexpr         char CHARACTER_l    { 'l' };
+constexpr         char CHARACTER_o    { 'o' };
+constexpr         char CHARACTER_equal{ '=' };
+
+/// @brief Long flags, written after "--". Those that require a value accept it after '=' or as the next argument.
+constexpr std::string_view LONG_FLAG_ISA         { "isa" };
+constexpr std::string_view LONG_FLAG_THREADS     { "threads" };
+constexpr std::string_view LONG_FLAG_STREAM      { "stream" };
+constexpr std::string_view LONG_FLAG_BUFFER_SIZE { "buffer-size" };
+constexpr std::string_view LONG_FLAG_IN_PLACE    { "in-place" };
+constexpr std::string_view LONG_FLAG_BATCH       { "batch" };
+constexpr std::string_view LONG_FLAG_LIST        { "list" };
+constexpr std::string_view LONG_FLAG_MIRROR      { "mirror" };
+constexpr std::string_view LONG_FLAG_CRACK       { "crack" };
+constexpr std::string_view LONG_FLAG_TOP         { "top" };
+constexpr std::string_view LONG_FLAG_SAMPLE      { "sample" };
+constexpr std::string_view LONG_FLAG_CRIB        { "crib" };
+constexpr std::string_view LONG_FLAG_BUILD_INDEX { "build-index" };
+constexpr std::string_view LONG_FLAG_INDEX       { "index" };
+constexpr std::string_view LONG_FLAG_STATS       { "stats" };
+constexpr std::string_view LONG_FLAG_PERF        { "perf" };
+constexpr std::string_view LONG_FLAG_TRACE       { "trace" };
+
+/// @brief Characters pushed in the queue of parameters by the long flags that require a value. They are uppercase so
+///        they never match a short flag.
+constexpr         char PARAMETER_ISA         { 'I' };
+constexpr         char PARAMETER_THREADS     { 'T' };
+constexpr         char PARAMETER_BUFFER_SIZE { 'B' };
+constexpr         char PARAMETER_BATCH       { 'D' };
+constexpr         char PARAMETER_LIST        { 'L' };
+constexpr         char PARAMETER_MIRROR      { 'M' };
+constexpr         char PARAMETER_TOP         { 'K' };
+constexpr         char PARAMETER_SAMPLE      { 'S' };
+constexpr         char PARAMETER_CRIB        { 'C' };
+constexpr         char PARAMETER_BUILD_INDEX { 'X' };
+constexpr         char PARAMETER_INDEX       { 'Q' };
+constexpr         char PARAMETER_TRACE       { 'R' };
+
+/// @brief Suffixes of the sizes in kibibytes and mebibytes.
+constexpr         char CHARACTER_K    { 'k' };
+constexpr         char CHARACTER_M    { 'm' };
 
 /// @brief Yes/No characters.
 constexpr         char CHARACTER_y    { 'y' };
@@ -51,23 +102,97 @@ constexpr          int EXCEPTION_2  { 2 };
 constexpr          int EXCEPTION_3  { 3 };
 constexpr          int EXCEPTION_4  { 4 };
 constexpr          int EXCEPTION_5  { 5 };
+constexpr          int EXCEPTION_6  { 6 };
+constexpr          int EXCEPTION_7  { 7 };
+constexpr          int EXCEPTION_8  { 8 };
+constexpr          int EXCEPTION_9  { 9 };
+constexpr          int EXCEPTION_10 { 10 };
+constexpr          int EXCEPTION_11 { 11 };
+constexpr          int EXCEPTION_12 { 12 };
+constexpr          int EXCEPTION_13 { 13 };
+constexpr          int EXCEPTION_14 { 14 };
+constexpr          int EXCEPTION_15 { 15 };
+constexpr          int EXCEPTION_16 { 16 };
+constexpr          int EXCEPTION_17 { 17 };
+constexpr          int EXCEPTION_18 { 18 };
+constexpr          int EXCEPTION_19 { 19 };
+constexpr          int EXCEPTION_20 { 20 };
+constexpr          int EXCEPTION_21 { 21 };
+constexpr          int EXCEPTION_22 { 22 };
+constexpr          int EXCEPTION_23 { 23 };
+constexpr          int EXCEPTION_24 { 24 };
+constexpr          int EXCEPTION_25 { 25 };
+constexpr          int EXCEPTION_26 { 26 };
 
 /// @brief Levels.
 constexpr          int MIN_LEVEL         {  1 };
 constexpr          int MAX_LEVEL_ENGLISH { 25 };
 constexpr          int MAX_LEVEL_SPANISH { 26 };
 
+/// @brief Threads.
+constexpr          int MIN_THREADS       {   1 };
+constexpr          int MAX_THREADS       { 256 };
+
+/// @brief Sizes of the buffers, in bytes.
+constexpr  std::size_t BULK_BLOCK_SIZE   { 64 * 1024 };          //Input transformed at several levels while it is in cache.
+constexpr  std::size_t BULK_MEMORY_LIMIT { 128 * 1024 * 1024 };  //Output of the levels waiting for their turn kept in memory.
+constexpr  std::size_t MIN_CHUNK_SIZE    { 1024 * 1024 };        //Smallest piece of a text transformed by a thread on its own.
+constexpr  std::size_t OUTPUT_BUFFER_SIZE{ 1024 * 1024 };        //Output gathered before writing it, and the size of a pipe.
+constexpr  std::size_t BATCH_MEMORY_LIMIT{ 128 * 1024 * 1024 };  //Files of a batch read, transformed or written at the same time.
+
+/// @brief Biggest number of files of a batch read, transformed or written at the same time.
+constexpr  std::size_t BATCH_FILES_IN_FLIGHT { 32 };
+
+/// @brief Sizes of the blocks read from a file in streaming mode, in bytes.
+constexpr  std::size_t MIN_BUFFER_SIZE     { 4 * 1024 };
+constexpr  std::size_t MAX_BUFFER_SIZE     { 1024 * 1024 * 1024 };
+constexpr  std::size_t DEFAULT_BUFFER_SIZE { 1024 * 1024 };
+
+/// @brief Sizes of the start of the input analyzed by --crack, in bytes.
+constexpr  std::size_t MIN_SAMPLE_SIZE     { 1024 };
+constexpr  std::size_t MAX_SAMPLE_SIZE     { 1024 * 1024 * 1024 };
+
+/// @brief Characters of the level lists.
+constexpr         char CHARACTER_comma{ ',' };
+constexpr         char CHARACTER_dash { '-' };
+
 /// @brief Empty string.
 constexpr std::string_view STRING_EMPTY { "" };
 
+/// @brief Path of the file that means the standard input.
+constexpr std::string_view STANDARD_INPUT_PATH { "-" };
+
+/// @brief Name of the manifest kept in the output directory of a mirror, and the first word of its header.
+constexpr std::string_view MIRROR_MANIFEST_NAME  { ".caesar-manifest" };
+constexpr std::string_view MIRROR_MANIFEST_MAGIC { "caesar-manifest-1" };
+
+/// @brief First bytes of a crib index, and the letters of its fingerprints. An index with others is rejected.
+constexpr std::string_view CRIB_INDEX_MAGIC        { "caesar-index-1" };
+constexpr          int     CRIB_INDEX_GRAM_LETTERS { 5 };
+
 /// @brief Languages.
 constexpr std::string_view ENGLISH_LANGUAGE { "en" };
 constexpr std::string_view SPANISH_LANGUAGE { "sp" };
 
+/// @brief Instruction sets.
+constexpr std::string_view ISA_SCALAR { "scalar" };
+constexpr std::string_view ISA_SSE2   { "sse2" };
+constexpr std::string_view ISA_AVX2   { "avx2" };
+constexpr std::string_view ISA_AVX512 { "avx512" };
+
 /// @brief Alfabets.
 constexpr std::string_view englishUppercaseAlphabet { "ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
 constexpr std::string_view englishLowercaseAlphabet { "abcdefghijklmnopqrstuvwxyz" };
 constexpr std::string_view spanishUppercaseAlphabet { "ABCDEFGHIJKLMNÑOPQRSTUVWXYZ" };
 constexpr std::string_view spanishLowercaseAlphabet { "abcdefghijklmnñopqrstuvwxyz" };
 
+/// @brief Alfabets decoded in code points at compile time.
+constexpr auto englishUppercaseCodePoints { decodeUTF8Text<countUTF8Characters(englishUppercaseAlphabet)>(englishUppercaseAlphabet) };
+constexpr auto englishLowercaseCodePoints { decodeUTF8Text<countUTF8Characters(englishLowercaseAlphabet)>(englishLowercaseAlphabet) };
+constexpr auto spanishUppercaseCodePoints { decodeUTF8Text<countUTF8Characters(spanishUppercaseAlphabet)>(spanishUppercaseAlphabet) };
+constexpr auto spanishLowercaseCodePoints { decodeUTF8Text<countUTF8Characters(spanishLowercaseAlphabet)>(spanishLowercaseAlphabet) };
+
+static_assert(englishUppercaseCodePoints.size() == MAX_LEVEL_ENGLISH + 1 && englishLowercaseCodePoints.size() == MAX_LEVEL_ENGLISH + 1);
+static_assert(spanishUppercaseCodePoints.size() == MAX_LEVEL_SPANISH + 1 && spanishLowercaseCodePoints.size() == MAX_LEVEL_SPANISH + 1);
+
 } // SherpadCaesar
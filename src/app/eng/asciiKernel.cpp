@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include "asciiKernel.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+   #include <immintrin.h>
+   #define CAESAR_X86 1
+#endif
+
+namespace SherpadCaesar {
+
+namespace {
+
+/// @brief Number of letters of the English alphabet.
+constexpr int ENGLISH_LETTERS { 26 };
+
+///==============================================================================
+/// @brief Rotates the ASCII letters one byte at a time.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored.
+/// @param shift Positions to move each letter forward (0 to 25).
+///==============================================================================
+void
+scalarKernel(const char* input, const std::size_t length, char* output, const int shift) noexcept{
+
+    for (std::size_t i= 0; i < length; i++){
+       const unsigned char byte  { static_cast<unsigned char>(input[i]) };
+       const unsigned char upper { static_cast<unsigned char>(byte - 'A') };
+       const unsigned char lower { static_cast<unsigned char>(byte - 'a') };
+
+       if (upper < ENGLISH_LETTERS)
+          output[i]= static_cast<char>('A' + (upper + shift) % ENGLISH_LETTERS);
+       else if (lower < ENGLISH_LETTERS)
+          output[i]= static_cast<char>('a' + (lower + shift) % ENGLISH_LETTERS);
+       else
+          output[i]= input[i];
+    }
+}
+
+#ifdef CAESAR_X86
+
+///==============================================================================
+/// @brief Rotates the ASCII letters 16 bytes at a time with SSE2.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored.
+/// @param shift Positions to move each letter forward (0 to 25).
+///==============================================================================
+__attribute__((target("sse2"))) void
+sse2Kernel(const char* input, const std::size_t length, char* output, const int shift) noexcept{
+
+    //Bytes over 0x7F are negative, so the signed comparisons never take them as letters.
+    const __m128i beforeUpper { _mm_set1_epi8('A' - 1) };
+    const __m128i afterUpper  { _mm_set1_epi8('Z' + 1) };
+    const __m128i beforeLower { _mm_set1_epi8('a' - 1) };
+    const __m128i afterLower  { _mm_set1_epi8('z' + 1) };
+    const __m128i baseUpper   { _mm_set1_epi8('A') };
+    const __m128i baseLower   { _mm_set1_epi8('a') };
+    const __m128i lastLetter  { _mm_set1_epi8(ENGLISH_LETTERS - 1) };
+    const __m128i numLetters  { _mm_set1_epi8(ENGLISH_LETTERS) };
+    const __m128i scrolling   { _mm_set1_epi8(static_cast<char>(shift)) };
+          std::size_t i       { 0 };
+
+    for (; i + 16 <= length; i+= 16){
+       const __m128i bytes    { _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)) };
+       const __m128i isUpper  { _mm_and_si128(_mm_cmpgt_epi8(bytes, beforeUpper), _mm_cmplt_epi8(bytes, afterUpper)) };
+       const __m128i isLower  { _mm_and_si128(_mm_cmpgt_epi8(bytes, beforeLower), _mm_cmplt_epi8(bytes, afterLower)) };
+       const __m128i isLetter { _mm_or_si128(isUpper, isLower) };
+       const __m128i base     { _mm_or_si128(_mm_and_si128(isUpper, baseUpper), _mm_and_si128(isLower, baseLower)) };
+             __m128i position { _mm_add_epi8(_mm_sub_epi8(bytes, base), scrolling) };
+
+       position= _mm_sub_epi8(position, _mm_and_si128(_mm_cmpgt_epi8(position, lastLetter), numLetters));
+
+       const __m128i letters  { _mm_add_epi8(base, position) };
+
+       _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_or_si128(_mm_and_si128(isLetter, letters), _mm_andnot_si128(isLetter, bytes)));
+    }
+
+    scalarKernel(input + i, length - i, output + i, shift);
+}
+
+///==============================================================================
+/// @brief Rotates the ASCII letters 32 bytes at a time with AVX2.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored.
+/// @param shift Positions to move each letter forward (0 to 25).
+///==============================================================================
+__attribute__((target("avx2"))) void
+avx2Kernel(const char* input, const std::size_t length, char* output, const int shift) noexcept{
+
+    const __m256i beforeUpper { _mm256_set1_epi8('A' - 1) };
+    const __m256i afterUpper  { _mm256_set1_epi8('Z' + 1) };
+    const __m256i beforeLower { _mm256_set1_epi8('a' - 1) };
+    const __m256i afterLower  { _mm256_set1_epi8('z' + 1) };
+    const __m256i baseUpper   { _mm256_set1_epi8('A') };
+    const __m256i baseLower   { _mm256_set1_epi8('a') };
+    const __m256i lastLetter  { _mm256_set1_epi8(ENGLISH_LETTERS - 1) };
+    const __m256i numLetters  { _mm256_set1_epi8(ENGLISH_LETTERS) };
+    const __m256i scrolling   { _mm256_set1_epi8(static_cast<char>(shift)) };
+          std::size_t i       { 0 };
+
+    for (; i + 32 <= length; i+= 32){
+       const __m256i bytes    { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)) };
+       const __m256i isUpper  { _mm256_and_si256(_mm256_cmpgt_epi8(bytes, beforeUpper), _mm256_cmpgt_epi8(afterUpper, bytes)) };
+       const __m256i isLower  { _mm256_and_si256(_mm256_cmpgt_epi8(bytes, beforeLower), _mm256_cmpgt_epi8(afterLower, bytes)) };
+       const __m256i isLetter { _mm256_or_si256(isUpper, isLower) };
+       const __m256i base     { _mm256_or_si256(_mm256_and_si256(isUpper, baseUpper), _mm256_and_si256(isLower, baseLower)) };
+             __m256i position { _mm256_add_epi8(_mm256_sub_epi8(bytes, base), scrolling) };
+
+       position= _mm256_sub_epi8(position, _mm256_and_si256(_mm256_cmpgt_epi8(position, lastLetter), numLetters));
+
+       _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_blendv_epi8(bytes, _mm256_add_epi8(base, position), isLetter));
+    }
+
+    scalarKernel(input + i, length - i, output + i, shift);
+}
+
+///==============================================================================
+/// @brief Rotates the ASCII letters 64 bytes at a time with AVX-512BW.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored.
+/// @param shift Positions to move each letter forward (0 to 25).
+///==============================================================================
+__attribute__((target("avx512f,avx512bw"))) void
+avx512Kernel(const char* input, const std::size_t length, char* output, const int shift) noexcept{
+
+    const __m512i baseUpper   { _mm512_set1_epi8('A') };
+    const __m512i baseLower   { _mm512_set1_epi8('a') };
+    const __m512i numLetters  { _mm512_set1_epi8(ENGLISH_LETTERS) };
+    const __m512i scrolling   { _mm512_set1_epi8(static_cast<char>(shift)) };
+          std::size_t i       { 0 };
+
+    //The tail is loaded and stored with a mask, so there is no scalar loop.
+    while (i < length){
+       const std::size_t remaining { length - i };
+       const __mmask64   valid     { remaining >= 64 ? ~__mmask64 { 0 } : (__mmask64 { 1 } << remaining) - 1 };
+       const __m512i     bytes     { _mm512_maskz_loadu_epi8(valid, input + i) };
+       const __m512i     upper     { _mm512_sub_epi8(bytes, baseUpper) };
+       const __m512i     lower     { _mm512_sub_epi8(bytes, baseLower) };
+       const __mmask64   isUpper   { _mm512_cmplt_epu8_mask(upper, numLetters) };
+       const __mmask64   isLower   { _mm512_cmplt_epu8_mask(lower, numLetters) };
+             __m512i     position  { _mm512_mask_blend_epi8(isUpper, lower, upper) };
+
+       position= _mm512_add_epi8(position, scrolling);
+       position= _mm512_mask_sub_epi8(position, _mm512_cmpge_epu8_mask(position, numLetters), position, numLetters);
+
+       const __m512i     letters   { _mm512_add_epi8(_mm512_mask_blend_epi8(isUpper, baseLower, baseUpper), position) };
+
+       _mm512_mask_storeu_epi8(output + i, valid, _mm512_mask_blend_epi8(isUpper | isLower, bytes, letters));
+
+       i+= 64;
+    }
+}
+
+#endif // CAESAR_X86
+
+} // namespace
+
+///==============================================================================
+/// @brief Detects the widest instruction set supported by the processor. The
+///        processor is only queried the first time.
+/// @return The widest instruction set supported.
+///==============================================================================
+Isa_t
+detectIsa() noexcept{
+
+    static const Isa_t detected { [](){
+#ifdef CAESAR_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+           return avx512Isa;
+        if (__builtin_cpu_supports("avx2"))
+           return avx2Isa;
+        if (__builtin_cpu_supports("sse2"))
+           return sse2Isa;
+#endif
+        return scalarIsa;
+    }() };
+
+    return detected;
+}
+
+///==============================================================================
+/// @brief Chooses the instruction set to use.
+/// @param requested Instruction set requested by the user. automaticIsa to use
+///        the widest one supported.
+/// @return The requested instruction set, or the widest supported one below it
+///         if the processor doesn't support it.
+///==============================================================================
+Isa_t
+selectIsa(const Isa_t requested) noexcept{
+
+    const Isa_t detected { detectIsa() };
+
+    if (requested == automaticIsa || requested > detected)
+       return detected;
+    else
+       return requested;
+}
+
+///==============================================================================
+/// @brief Gets the kernel of an instruction set.
+/// @param isa Instruction set. It isn't checked against the processor, use
+///        selectIsa before.
+/// @return The kernel.
+///==============================================================================
+AsciiKernel_t
+getAsciiKernel(const Isa_t isa) noexcept{
+
+    switch (isa){
+#ifdef CAESAR_X86
+       case sse2Isa:
+          return sse2Kernel;
+       case avx2Isa:
+          return avx2Kernel;
+       case avx512Isa:
+          return avx512Kernel;
+#endif
+       default:
+          return scalarKernel;
+    }
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include "../dat/utils/utils.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Kernel that rotates the ASCII letters of a text with the English alphabet. The rest of bytes are copied.
+///        Parameters: input, size of the input in bytes, output with the same size and shift between 0 and 25.
+using AsciiKernel_t= void (*)(const char*, const std::size_t, char*, const int);
+
+      Isa_t            detectIsa()                                        noexcept;
+      Isa_t            selectIsa(const Isa_t)                             noexcept;
+      AsciiKernel_t    getAsciiKernel(const Isa_t)                        noexcept;
+
+} // namespace SherpadCaesar
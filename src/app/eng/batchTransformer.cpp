@@ -0,0 +1,519 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+#include "../dat/utils/hash.hpp"
+#include "../dat/utils/utils.hpp"
+#include "../io/ioRing.hpp"
+#include "../trace/traceRecorder.hpp"
+#include "batchTransformer.hpp"
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief State of a file of the batch, from the moment it is opened until it is written.
+struct BatchTransformer_t::Job_t{
+                                                              /// @brief Path of the input file.
+                                                std::string   inputPath           { };
+
+                                                              /// @brief Path of the output file.
+                                                std::string   outputPath          { };
+
+                                                              /// @brief Why the file couldn't be transformed. Empty if it was.
+                                                std::string   error               { };
+
+                                                              /// @brief Descriptors of the input and the output files. -1 when they are closed.
+                                                        int   input               { -1 };
+                                                        int   output              { -1 };
+
+                                                              /// @brief Content of the input file and room for the line break that ends the output. It is
+                                                              ///        transformed over itself when its size doesn't change.
+                                    std::unique_ptr<char[]>   text                { };
+
+                                                              /// @brief Transformed content and its line break when its size can change.
+                                    std::unique_ptr<char[]>   transformed         { };
+
+                                                              /// @brief Size of the input file in bytes.
+                                                std::size_t   size                { 0 };
+
+                                                              /// @brief Transformed content to write and its size, with the line break.
+                                                 const char*  result              { nullptr };
+                                                std::size_t   resultSize          { 0 };
+
+                                                              /// @brief Bytes already read or written.
+                                                std::size_t   done                { 0 };
+
+                                                              /// @brief Memory taken by the buffers of the file.
+                                                std::size_t   memory              { 0 };
+
+                                                              /// @brief Hash of the content of the input file. An empty file keeps the initial value.
+                                              std::uint64_t   hash                { FNV1A_OFFSET_BASIS };
+
+                                                              /// @brief Indicates whether the file is being written instead of read.
+                                                       bool   writing             { false };
+};
+
+/// @brief Value given to the read of the eventfd that tells that files are transformed. The files use their index plus one.
+constexpr std::uint64_t TRANSFORMED_EVENT { 0 };
+
+///==============================================================================
+/// @brief Constructor of the BatchTransformer_t class.
+/// @param transformer Transformer of the language, level and direction.
+/// @param threads Number of threads. If it is 0, one per hardware thread.
+/// @param hashInputs Indicates whether the content of the input files is
+///        hashed before it is transformed.
+///==============================================================================
+BatchTransformer_t::BatchTransformer_t(const Transformer_t& transformer, const std::size_t threads, const bool hashInputs)
+    : m_transformer { transformer }, m_threads { threads > 0 ? threads : getDefaultThreads() }, m_hashInputs { hashInputs } {
+
+}
+
+///==============================================================================
+/// @brief Transforms the files. Two files with the same name would write the
+///        same output file, so only the first one is transformed.
+/// @param paths Paths of the input files.
+/// @param outputDirectory Directory where the output files are written.
+/// @return The result of every file, in the order of the paths.
+///==============================================================================
+std::vector<BatchResult_t>
+BatchTransformer_t::run(const std::vector<std::string>& paths, const std::string_view outputDirectory) const{
+
+    std::vector<Job_t>              jobs  ( paths.size() );
+    std::unordered_set<std::string> names { };
+
+    for (std::size_t i= 0; i < paths.size(); i++){
+       const std::string name { std::filesystem::path { paths[i] }.filename().string() };
+
+       jobs[i].inputPath = paths[i];
+       jobs[i].outputPath= (std::filesystem::path { outputDirectory } / name).string();
+
+       if (name.empty())
+          jobs[i].error= "It isn't a file.";
+       else if (!names.insert(name).second)
+          jobs[i].error= "Another file of the batch has the same name.";
+    }
+
+    return runJobs(jobs);
+}
+
+///==============================================================================
+/// @brief Transforms the files, each one into its own output file. The output
+///        directories must exist.
+/// @param paths Paths of the input files.
+/// @param outputPaths Paths of the output files, in the order of the inputs.
+/// @return The result of every file, in the order of the paths.
+///==============================================================================
+std::vector<BatchResult_t>
+BatchTransformer_t::run(const std::vector<std::string>& paths, const std::vector<std::string>& outputPaths) const{
+
+    std::vector<Job_t> jobs ( paths.size() );
+
+    for (std::size_t i= 0; i < paths.size(); i++){
+       jobs[i].inputPath = paths[i];
+       jobs[i].outputPath= outputPaths[i];
+    }
+
+    return runJobs(jobs);
+}
+
+///==============================================================================
+/// @brief Runs the jobs of a batch with io_uring, or with the pool if the ring
+///        isn't available.
+/// @param jobs Files of the batch.
+/// @return The result of every file, in the order of the jobs.
+///==============================================================================
+std::vector<BatchResult_t>
+BatchTransformer_t::runJobs(std::vector<Job_t>& jobs) const{
+
+    std::vector<BatchResult_t> results    { };
+    //The ring can still be reading the eventfd into it until the ring is destroyed.
+    std::uint64_t              eventValue { 0 };
+
+    {
+       IoRing_t  ring  { static_cast<unsigned>(2 * BATCH_FILES_IN_FLIGHT + 1) };
+       const int event { ring.isAvailable() ? ::eventfd(0, EFD_CLOEXEC) : -1 };
+
+       if (event >= 0){
+          runWithRing(ring, event, eventValue, jobs);
+          ::close(event);
+       }
+       else
+          runWithPool(jobs);
+    }
+
+    results.reserve(jobs.size());
+
+    for (Job_t& job : jobs)
+       results.push_back(BatchResult_t { std::move(job.inputPath), std::move(job.error), job.hash });
+
+    return results;
+}
+
+///==============================================================================
+/// @brief Runs the batch with io_uring. This thread opens the files and queues
+///        their reads and writes; the pool transforms the files already read
+///        and tells it through the eventfd.
+/// @param ring Ring where the reads and writes are queued.
+/// @param event Eventfd written by the pool after a file is transformed.
+/// @param eventValue Where the eventfd is read. It must outlive the ring.
+/// @param jobs Files of the batch.
+///==============================================================================
+void
+BatchTransformer_t::runWithRing(IoRing_t& ring, const int event, std::uint64_t& eventValue, std::vector<Job_t>& jobs) const{
+
+          std::mutex               mutex       { };
+          std::vector<std::size_t> transformed { };
+          std::size_t              next        { 0 };
+          std::size_t              inFlight    { 0 };
+          std::size_t              memory      { 0 };
+          //It is destroyed first, so no thread is left using the jobs if something fails.
+          WorkerPool_t             pool        { m_threads };
+
+//==============================================================================
+//                         LAMBDA finish
+//==============================================================================
+    auto finish= [&](Job_t& job, const std::string& error){
+        memory-= job.memory;
+        inFlight--;
+        finishJob(job, error);
+    };
+
+//==============================================================================
+//                         LAMBDA transform
+//==============================================================================
+    auto transform= [&](const std::size_t index){
+        Job_t& job { jobs[index] };
+
+        ::close(job.input);
+        job.input= -1;
+
+        pool.submit([this, &job, &mutex, &transformed, event, index](){
+           transformJob(job);
+
+           {
+              std::lock_guard<std::mutex> lock { mutex };
+              transformed.push_back(index);
+           }
+
+           ::eventfd_write(event, 1);
+        });
+    };
+
+    ring.prepareRead(event, reinterpret_cast<char*>(&eventValue), sizeof(eventValue), 0, TRANSFORMED_EVENT);
+
+    while (next < jobs.size() || inFlight > 0){
+       //A file bigger than the limit is read alone.
+       while (next < jobs.size() && inFlight < BATCH_FILES_IN_FLIGHT && (inFlight == 0 || memory < BATCH_MEMORY_LIMIT)){
+          Job_t& job { jobs[next] };
+
+          if (job.error.empty() && openJob(job)){
+             //A file too big for the memory fails alone, like in the pool.
+             try{
+                allocateJob(job);
+             }
+             catch (const std::bad_alloc&){
+                finishJob(job, std::strerror(ENOMEM));
+                next++;
+                continue;
+             }
+
+             memory+= job.memory;
+             inFlight++;
+
+             //An empty file has nothing to read, but its output still has the line break.
+             if (job.size == 0)
+                transform(next);
+             else
+                ring.prepareRead(job.input, job.text.get(), job.size, 0, next + 1);
+          }
+          else
+             finishJob(job, job.error);
+
+          next++;
+       }
+
+       if (inFlight == 0)
+          continue;
+
+       {
+          TraceSpan_t span { "wait", "io" };
+
+          span.setArgument("files", static_cast<long long>(inFlight));
+          ring.submitAndWait(1);
+       }
+
+       IoCompletion_t completion { };
+
+       while (ring.nextCompletion(completion)){
+          if (completion.userData == TRANSFORMED_EVENT){
+             std::vector<std::size_t> ready { };
+
+             {
+                std::lock_guard<std::mutex> lock { mutex };
+                ready.swap(transformed);
+             }
+
+             for (const std::size_t index : ready){
+                Job_t& job { jobs[index] };
+
+                job.writing= true;
+                job.done   = 0;
+                ring.prepareWrite(job.output, job.result, job.resultSize, 0, index + 1);
+             }
+
+             ring.prepareRead(event, reinterpret_cast<char*>(&eventValue), sizeof(eventValue), 0, TRANSFORMED_EVENT);
+             continue;
+          }
+
+          const std::size_t index { completion.userData - 1 };
+                Job_t&      job   { jobs[index] };
+
+          if (completion.result < 0){
+             finish(job, std::strerror(-completion.result));
+             continue;
+          }
+
+          job.done+= static_cast<std::size_t>(completion.result);
+
+          if (!job.writing){
+             //The file got shorter while it was read: what was read is transformed.
+             if (completion.result == 0)
+                job.size= job.done;
+
+             if (job.done < job.size)
+                ring.prepareRead(job.input, job.text.get() + job.done, job.size - job.done, job.done, index + 1);
+             else
+                transform(index);
+          }
+          else if (completion.result == 0)
+             finish(job, std::strerror(EIO));
+          else if (job.done < job.resultSize)
+             ring.prepareWrite(job.output, job.result + job.done, job.resultSize - job.done, job.done, index + 1);
+          else
+             finish(job, "");
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Runs the batch without io_uring. Every thread of the pool reads,
+///        transforms and writes its own files, so they overlap as well. The
+///        memory of the files in flight is limited like with io_uring: a file
+///        waits while BATCH_MEMORY_LIMIT is used, and a bigger one is alone.
+/// @param jobs Files of the batch.
+///==============================================================================
+void
+BatchTransformer_t::runWithPool(std::vector<Job_t>& jobs) const{
+
+    std::mutex                     mutex    { };
+    std::condition_variable        released { };
+    std::size_t                    memory   { 0 };
+    std::vector<std::future<void>> tasks    { };
+    //It is destroyed first, so no thread is left using the memory if something fails.
+    WorkerPool_t                   pool     { m_threads };
+
+//==============================================================================
+//                         LAMBDA transfer
+//==============================================================================
+    auto transfer= [](const int fileDescriptor, char* buffer, std::size_t& size, const bool isWrite){
+        TraceSpan_t span { isWrite ? "write" : "read", "io" };
+        std::size_t done { 0 };
+
+        span.setArgument("bytes", static_cast<long long>(size));
+
+        while (done < size){
+           const ssize_t nBytes { isWrite ? ::pwrite(fileDescriptor, buffer + done, size - done, static_cast<off_t>(done))
+                                          : ::pread(fileDescriptor, buffer + done, size - done, static_cast<off_t>(done)) };
+
+           if (nBytes < 0 && errno == EINTR)
+              continue;
+           if (nBytes < 0)
+              return std::string { std::strerror(errno) };
+           if (nBytes == 0 && isWrite)
+              return std::string { std::strerror(EIO) };
+           //A file that got shorter while it was read ends there.
+           if (nBytes == 0)
+              size= done;
+
+           done+= static_cast<std::size_t>(nBytes);
+        }
+
+        return std::string { };
+    };
+
+    tasks.reserve(jobs.size());
+
+    for (Job_t& job : jobs){
+       tasks.push_back(pool.submit([this, &job, &mutex, &released, &memory, transfer](){
+          if (!job.error.empty() || !openJob(job)){
+             finishJob(job, job.error);
+             return;
+          }
+
+          {
+             std::unique_lock<std::mutex> lock { mutex };
+
+             released.wait(lock, [&memory](){ return memory == 0 || memory < BATCH_MEMORY_LIMIT; });
+             memory+= job.memory;
+          }
+
+          std::string error { };
+
+          try{
+             allocateJob(job);
+             error= transfer(job.input, job.text.get(), job.size, false);
+
+             if (error.empty()){
+                transformJob(job);
+                error= transfer(job.output, const_cast<char*>(job.result), job.resultSize, true);
+             }
+          }
+          catch (const std::bad_alloc&){
+             error= std::strerror(ENOMEM);
+          }
+
+          finishJob(job, error);
+
+          {
+             std::lock_guard<std::mutex> lock { mutex };
+
+             memory-= job.memory;
+          }
+
+          released.notify_all();
+       }));
+    }
+
+    for (std::future<void>& task : tasks)
+       task.get();
+}
+
+///==============================================================================
+/// @brief Opens the input and the output files of a job and works out the
+///        memory for their content.
+/// @param job File of the batch. Its error is informed if it fails.
+/// @return true whether both files were opened.
+///==============================================================================
+bool
+BatchTransformer_t::openJob(Job_t& job) const{
+
+    struct stat     status { };
+    std::error_code eCode;
+
+    job.input= ::open(job.inputPath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (job.input < 0 || ::fstat(job.input, &status) < 0){
+       job.error= std::strerror(errno);
+       return false;
+    }
+
+    if (!S_ISREG(status.st_mode)){
+       job.error= "This isn't a regular file.";
+       return false;
+    }
+
+    //Truncating the output file would destroy the input before it is read.
+    if (std::filesystem::equivalent(job.inputPath, job.outputPath, eCode)){
+       job.error= "The output file is the input file.";
+       return false;
+    }
+
+    job.output= ::open(job.outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+    if (job.output < 0){
+       job.error= std::strerror(errno);
+       return false;
+    }
+
+    job.size  = static_cast<std::size_t>(status.st_size);
+    job.memory= job.size + 1;
+
+    if (!m_transformer.isLengthPreserving())
+       job.memory+= m_transformer.getMaxOutputLength(job.size) + 1;
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Reserves the memory for the content of a job, once it has room.
+/// @param job File of the batch, already opened.
+///==============================================================================
+void
+BatchTransformer_t::allocateJob(Job_t& job) const{
+
+    //The buffers aren't filled with zeros, they are overwritten right away.
+    job.text= std::unique_ptr<char[]> { new char[job.size + 1] };
+
+    if (!m_transformer.isLengthPreserving())
+       job.transformed= std::unique_ptr<char[]> { new char[m_transformer.getMaxOutputLength(job.size) + 1] };
+}
+
+///==============================================================================
+/// @brief Transforms the content of a job, over itself when its size doesn't
+///        change, and ends it with a line break, like the output of -f and
+///        -o. Its content is hashed first if the batch hashes its inputs.
+/// @param job File of the batch, already read.
+///==============================================================================
+void
+BatchTransformer_t::transformJob(Job_t& job) const noexcept{
+
+    TraceSpan_t span { "transform", "file" };
+
+    span.setArgument("bytes", static_cast<long long>(job.size));
+
+    //It is hashed before its length preserving transformation overwrites it.
+    if (m_hashInputs)
+       job.hash= fnv1a(job.text.get(), job.size);
+
+    if (job.transformed == nullptr){
+       m_transformer.transform(job.text.get(), job.size, job.text.get());
+       job.text[job.size]= '\n';
+       job.result        = job.text.get();
+       job.resultSize    = job.size + 1;
+    }
+    else{
+       job.resultSize= m_transformer.transform(job.text.get(), job.size, job.transformed.get());
+       job.transformed[job.resultSize++]= '\n';
+       job.result    = job.transformed.get();
+    }
+}
+
+///==============================================================================
+/// @brief Closes the files of a job and frees its memory. If it failed, the
+///        output file, which would be incomplete, is removed.
+/// @param job File of the batch.
+/// @param error Why the file couldn't be transformed. Empty if it was.
+///==============================================================================
+void
+BatchTransformer_t::finishJob(Job_t& job, const std::string& error){
+
+    if (job.input >= 0)
+       ::close(job.input);
+
+    if (job.output >= 0){
+       ::close(job.output);
+
+       if (!error.empty())
+          ::unlink(job.outputPath.c_str());
+    }
+
+    job.error      = error;
+    job.input      = -1;
+    job.output     = -1;
+    job.result     = nullptr;
+    job.text       .reset();
+    job.transformed.reset();
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "transformer.hpp"
+
+namespace SherpadCaesar{
+
+//Forward Declaration.
+class IoRing_t;
+
+/// @brief Result of a file of a batch.
+struct BatchResult_t{
+                                                              /// @brief Path of the input file.
+                                                std::string   path;
+
+                                                              /// @brief Why the file couldn't be transformed. Empty if it was.
+                                                std::string   error;
+
+                                                              /// @brief FNV-1a hash of the content of the input file, when the batch hashes its inputs.
+                                              std::uint64_t   hash                { 0 };
+};
+
+/// @class BatchTransformer_t
+/// @brief Transforms many files at a level, each one into a file with the same name in an output directory. Reads,
+///        transformations and writes of different files overlap: with io_uring the calling thread queues the reads
+///        and writes of up to BATCH_FILES_IN_FLIGHT files while a pool of threads transforms the ones already read;
+///        without it, every thread of the pool reads, transforms and writes its own files. Either way the files in
+///        flight take about BATCH_MEMORY_LIMIT at most. Every output ends with a line break, like the output of -f.
+///        A file that fails is reported and the rest of the batch goes on. The output files can also be given one by
+///        one, and the content of the input files can be hashed while it is in memory.
+
+    class BatchTransformer_t{
+        private:
+            struct Job_t;
+
+                                                              /// @brief Transformer of the language, level and direction.
+                                              Transformer_t   m_transformer;
+
+                                                              /// @brief Number of threads that transform the files.
+                                                std::size_t   m_threads;
+
+                                                              /// @brief Indicates whether the content of the input files is hashed before it is transformed.
+                                                       bool   m_hashInputs;
+
+                                                       bool   openJob(Job_t&)                                  const;
+                                                       void   allocateJob(Job_t&)                              const;
+                                                       void   transformJob(Job_t&)                             const noexcept;
+            static                                     void   finishJob(Job_t&, const std::string&);
+                                                       void   runWithRing(IoRing_t&, const int, std::uint64_t&, std::vector<Job_t>&) const;
+                                                       void   runWithPool(std::vector<Job_t>&)                 const;
+                                 std::vector<BatchResult_t>   runJobs(std::vector<Job_t>&)                     const;
+
+        public:
+                                                              BatchTransformer_t(const Transformer_t&, const std::size_t= 1, const bool= false);
+                                                              BatchTransformer_t(const BatchTransformer_t&)            = delete;
+                                                              BatchTransformer_t(      BatchTransformer_t&&)           = delete;
+                                                             ~BatchTransformer_t()                                     = default;
+                                        BatchTransformer_t&   operator=(const BatchTransformer_t&)                     = delete;
+                                        BatchTransformer_t&   operator=(      BatchTransformer_t&&)                    = delete;
+                                 std::vector<BatchResult_t>   run(const std::vector<std::string>&, const std::string_view) const;
+                                 std::vector<BatchResult_t>   run(const std::vector<std::string>&, const std::vector<std::string>&) const;
+    };
+
+} // namespace SherpadCaesar
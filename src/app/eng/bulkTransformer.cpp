@@ -0,0 +1,314 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <future>
+#include <string>
+#include "../trace/traceRecorder.hpp"
+#include "bulkTransformer.hpp"
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+namespace {
+
+///==============================================================================
+/// @brief Transforms a text at some consecutive levels of a table in a single
+///        pass: every block is decoded once and written at all of them while it
+///        is still in cache.
+/// @param table Tables of the language, levels and direction.
+/// @param first Position of the first level in the list of levels.
+/// @param last Position after the last level in the list of levels.
+/// @param input Text to transform.
+/// @param stream Receives the first level as it is produced. If it is nullptr
+///        the first level is stored like the rest.
+/// @param levelOutputs Where the output of every level is stored, by position.
+///        Only the positions of these levels are modified.
+/// @param firstLevel Level at the first position, for the trace.
+///==============================================================================
+template <typename MultiLevelTable>
+void
+transformLevels(const MultiLevelTable& table, const std::size_t first, const std::size_t last, const std::string_view input,
+                const LevelOutput_t* stream, std::vector<std::string>& levelOutputs, const int firstLevel){
+
+    TraceSpan_t                         span    { "levels", "bulk" };
+    typename MultiLevelTable::Symbols_t decoded { };
+    std::vector<char>                   block   ( MultiLevelTable::getMaxOutputLength(BULK_BLOCK_SIZE) );
+    std::size_t                         start   { 0 };
+
+    span.setArgument("level", firstLevel);
+    span.setArgument("levels", static_cast<long long>(last - first));
+
+    for (std::size_t levelIndex= (stream != nullptr) ? first + 1 : first; levelIndex < last; levelIndex++)
+       levelOutputs[levelIndex].reserve(input.length());
+
+    while (start < input.length()){
+       std::size_t end { findUTF8Boundary(input.data(), input.length(), start + BULK_BLOCK_SIZE) };
+
+       if (end <= start)
+          end= std::min(start + BULK_BLOCK_SIZE, input.length());
+
+       table.decode(input.data() + start, end - start, decoded);
+
+       for (std::size_t levelIndex= first; levelIndex < last; levelIndex++){
+          const std::size_t size { table.emit(levelIndex, input.data() + start, end - start, decoded, block.data()) };
+
+          if (levelIndex == first && stream != nullptr)
+             stream->write(block.data(), size);
+          else
+             levelOutputs[levelIndex].append(block.data(), size);
+       }
+
+       start= end;
+    }
+}
+
+///==============================================================================
+/// @brief Transforms a piece of a text at a level of a table.
+/// @param table Tables of the language, levels and direction.
+/// @param levelIndex Position of the level in the list of levels.
+/// @param input Piece of the text to transform.
+/// @param stream Receives the output as it is produced. If it is nullptr the
+///        output is stored.
+/// @param chunkOutput Where the output is stored.
+/// @param level Level at the position, for the trace.
+///==============================================================================
+template <typename MultiLevelTable>
+void
+transformChunk(const MultiLevelTable& table, const std::size_t levelIndex, const std::string_view input, const LevelOutput_t* stream,
+               std::string& chunkOutput, const int level){
+
+    TraceSpan_t                         span    { "chunk", "bulk" };
+    typename MultiLevelTable::Symbols_t decoded { };
+    std::vector<char>                   block   ( MultiLevelTable::getMaxOutputLength(BULK_BLOCK_SIZE) );
+    std::size_t                         start   { 0 };
+
+    span.setArgument("level", level);
+    span.setArgument("bytes", static_cast<long long>(input.length()));
+
+    if (stream == nullptr)
+       chunkOutput.reserve(input.length());
+
+    while (start < input.length()){
+       std::size_t end { findUTF8Boundary(input.data(), input.length(), start + BULK_BLOCK_SIZE) };
+
+       if (end <= start)
+          end= std::min(start + BULK_BLOCK_SIZE, input.length());
+
+       table.decode(input.data() + start, end - start, decoded);
+
+       const std::size_t size { table.emit(levelIndex, input.data() + start, end - start, decoded, block.data()) };
+
+       if (stream != nullptr)
+          stream->write(block.data(), size);
+       else
+          chunkOutput.append(block.data(), size);
+
+       start= end;
+    }
+}
+
+///==============================================================================
+/// @brief Transforms a text at a level of a table split in chunks at character
+///        boundaries, shared out between the threads. The text is done in
+///        windows of BULK_MEMORY_LIMIT, so only the chunks of a window wait in
+///        memory; the calling thread writes the first chunk of every window as
+///        it is produced, and the rest in order.
+/// @param table Tables of the language, levels and direction.
+/// @param levelIndex Position of the level in the list of levels.
+/// @param level Level at the position.
+/// @param input Text to transform.
+/// @param pool Threads that transform the chunks after the first.
+/// @param chunkOutputs Where the output of every chunk is stored. There is one
+///        per thread, and it must outlive the pool.
+/// @param output Receives the output of the level.
+///==============================================================================
+template <typename MultiLevelTable>
+void
+runLevelInChunks(const MultiLevelTable& table, const std::size_t levelIndex, const int level, const std::string_view input, WorkerPool_t& pool,
+                 std::vector<std::string>& chunkOutputs, const LevelOutput_t& output){
+
+    output.begin(level);
+
+    for (std::size_t start= 0; start < input.length(); ){
+       std::size_t end { start + BULK_MEMORY_LIMIT < input.length() ? findUTF8Boundary(input.data(), input.length(), start + BULK_MEMORY_LIMIT) : input.length() };
+
+       if (end <= start)
+          end= std::min(start + BULK_MEMORY_LIMIT, input.length());
+
+       const std::string_view               window    { input.substr(start, end - start) };
+       const std::size_t                    numChunks { std::min(chunkOutputs.size(), std::max<std::size_t>(window.length() / MIN_CHUNK_SIZE, 1)) };
+             std::vector<std::size_t>       bounds    { 0 };
+             std::vector<std::future<void>> tasks     { };
+
+       for (std::size_t chunk= 1; chunk < numChunks; chunk++)
+          bounds.push_back(std::max(bounds.back(), findUTF8Boundary(window.data(), window.length(), chunk * window.length() / numChunks)));
+
+       bounds.push_back(window.length());
+
+       for (std::size_t chunk= 1; chunk < numChunks; chunk++)
+          tasks.push_back(pool.submit([&table, &chunkOutputs, levelIndex, level, chunk, piece= window.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk])](){
+             transformChunk(table, levelIndex, piece, nullptr, chunkOutputs[chunk], level);
+          }));
+
+       transformChunk(table, levelIndex, window.substr(0, bounds[1]), &output, chunkOutputs[0], level);
+
+       for (std::size_t chunk= 1; chunk < numChunks; chunk++){
+          {
+             TraceSpan_t span { "wait", "bulk" };
+
+             span.setArgument("level", level);
+             tasks[chunk - 1].get();
+          }
+
+          output.write(chunkOutputs[chunk].data(), chunkOutputs[chunk].length());
+          chunkOutputs[chunk].clear();
+       }
+
+       start= end;
+    }
+
+    output.end(level);
+}
+
+///==============================================================================
+/// @brief Writes the stored output of some consecutive levels and frees it.
+/// @param levels Levels of the table.
+/// @param first Position of the first level to write.
+/// @param last Position after the last level to write.
+/// @param levelOutputs Output of every level, by position.
+/// @param output Receives the output level by level.
+///==============================================================================
+void
+writeLevels(const std::vector<int>& levels, const std::size_t first, const std::size_t last, std::vector<std::string>& levelOutputs, const LevelOutput_t& output){
+
+    for (std::size_t levelIndex= first; levelIndex < last; levelIndex++){
+       TraceSpan_t span { "write", "bulk" };
+
+       span.setArgument("level", levels[levelIndex]);
+       span.setArgument("bytes", static_cast<long long>(levelOutputs[levelIndex].length()));
+       output.begin(levels[levelIndex]);
+       output.write(levelOutputs[levelIndex].data(), levelOutputs[levelIndex].length());
+       output.end(levels[levelIndex]);
+
+       std::string { }.swap(levelOutputs[levelIndex]);
+    }
+}
+
+///==============================================================================
+/// @brief Transforms a text at every level of a table. The levels are made in
+///        passes as big as BULK_MEMORY_LIMIT allows, so a small text needs one
+///        pass and a huge one a pass per level. The levels of a pass are shared
+///        out between the threads; the calling thread takes the first ones and
+///        writes the first level as it is produced, and the rest are written
+///        in order as soon as the levels before them are written. When a pass
+///        has fewer levels than threads, the text is too big to keep a level
+///        per thread, so every level is split in chunks between the threads
+///        instead.
+/// @param table Tables of the language, levels and direction.
+/// @param levels Levels of the table.
+/// @param input Text to transform.
+/// @param numThreads Number of threads, including the calling one.
+/// @param output Receives the output level by level.
+///==============================================================================
+template <typename MultiLevelTable>
+void
+runLevels(const MultiLevelTable& table, const std::vector<int>& levels, const std::string_view input, const std::size_t numThreads, const LevelOutput_t& output){
+
+    const std::size_t              levelsPerPass { 1 + BULK_MEMORY_LIMIT / std::max<std::size_t>(input.length(), 1) };
+    const bool                     isChunked     { levelsPerPass < std::min(numThreads, levels.size()) };
+          //The output of every level, or of every chunk of a level.
+          std::vector<std::string> levelOutputs  ( isChunked ? numThreads : levels.size() );
+          //It is destroyed first, so no thread is left using the outputs if something fails.
+          WorkerPool_t             pool          { (isChunked ? numThreads : std::min(numThreads, std::min(levelsPerPass, levels.size()))) - 1 };
+
+    if (isChunked){
+       for (std::size_t levelIndex= 0; levelIndex < levels.size(); levelIndex++)
+          runLevelInChunks(table, levelIndex, levels[levelIndex], input, pool, levelOutputs, output);
+
+       return;
+    }
+
+    for (std::size_t first= 0; first < levels.size(); first+= levelsPerPass){
+       const std::size_t                    last     { std::min(first + levelsPerPass, levels.size()) };
+       const std::size_t                    numTasks { std::min(pool.getNumWorkers() + 1, last - first) };
+             std::vector<std::size_t>       bounds   { };
+             std::vector<std::future<void>> tasks    { };
+
+       for (std::size_t task= 0; task <= numTasks; task++)
+          bounds.push_back(first + task * (last - first) / numTasks);
+
+       for (std::size_t task= 1; task < numTasks; task++)
+          tasks.push_back(pool.submit([&table, &input, &levelOutputs, taskFirst= bounds[task], taskLast= bounds[task + 1], level= levels[bounds[task]]](){
+             transformLevels(table, taskFirst, taskLast, input, nullptr, levelOutputs, level);
+          }));
+
+       output.begin(levels[first]);
+       transformLevels(table, bounds[0], bounds[1], input, &output, levelOutputs, levels[bounds[0]]);
+       output.end(levels[first]);
+       writeLevels(levels, bounds[0] + 1, bounds[1], levelOutputs, output);
+
+       for (std::size_t task= 1; task < numTasks; task++){
+          {
+             TraceSpan_t span { "wait", "bulk" };
+
+             span.setArgument("level", levels[bounds[task]]);
+             tasks[task - 1].get();
+          }
+
+          writeLevels(levels, bounds[task], bounds[task + 1], levelOutputs, output);
+       }
+    }
+}
+
+} // namespace
+
+///==============================================================================
+/// @brief Constructor of the BulkTransformer_t class.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param levels Levels to perform the transformation, in the order of output.
+///        It must not be empty.
+/// @param isa Instruction set of the ASCII kernel.
+/// @param threads Number of threads. If it is 0, one per hardware thread.
+///==============================================================================
+BulkTransformer_t::BulkTransformer_t(const Language_t language, const Direction_t direction, const std::vector<int>& levels, const Isa_t isa, const std::size_t threads)
+    : m_levels { levels }, m_table { makeTable(language, direction, levels, isa) }, m_threads { threads > 0 ? threads : getDefaultThreads() } {
+
+}
+
+///==============================================================================
+/// @brief Makes the specialization of the tables.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param levels Levels to perform the transformation.
+/// @param isa Instruction set of the ASCII kernel.
+/// @return The tables.
+///==============================================================================
+BulkTransformer_t::Table_t
+BulkTransformer_t::makeTable(const Language_t language, const Direction_t direction, const std::vector<int>& levels, const Isa_t isa){
+
+    switch (language){
+       case spanishLanguage:
+          if (direction == encryptDirection)
+             return MultiLevelTable_t<spanishLanguage>::make<encryptDirection>(levels, isa);
+          else
+             return MultiLevelTable_t<spanishLanguage>::make<decryptDirection>(levels, isa);
+       default:
+          if (direction == encryptDirection)
+             return MultiLevelTable_t<englishLanguage>::make<encryptDirection>(levels, isa);
+          else
+             return MultiLevelTable_t<englishLanguage>::make<decryptDirection>(levels, isa);
+    }
+}
+
+///==============================================================================
+/// @brief Transforms a text at all the levels.
+/// @param input Text to transform.
+/// @param output Receives the output level by level.
+///==============================================================================
+void
+BulkTransformer_t::run(const std::string_view input, const LevelOutput_t& output) const{
+
+    std::visit([&](const auto& table){ runLevels(table, m_levels, input, m_threads, output); }, m_table);
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "multiLevelTable.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Receives the output of several levels, one whole level after another in the order of the list.
+struct LevelOutput_t{
+                                                              /// @brief Called before the output of a level. Receives the level.
+                           std::function<void(const int)>     begin;
+
+                                                              /// @brief Called with every piece of output of the current level.
+         std::function<void(const char*, const std::size_t)>  write;
+
+                                                              /// @brief Called after the output of a level. Receives the level.
+                           std::function<void(const int)>     end;
+};
+
+/// @class BulkTransformer_t
+/// @brief Transforms a text at several levels reading it as few times as possible. Every block of the input is decoded
+///        once and written at a group of levels while it is still in cache. The first level of the group is written
+///        as it is produced; the rest are kept in per-level buffers and written afterwards in the order of the list.
+///        The levels can be shared out between several threads; the output keeps the order of the list.
+
+    class BulkTransformer_t{
+        private:
+            using Table_t= std::variant<MultiLevelTable_t<englishLanguage>, MultiLevelTable_t<spanishLanguage>>;
+
+                                                              /// @brief Levels to perform the transformation.
+                                           std::vector<int>   m_levels;
+
+                                                              /// @brief Tables of the language, levels and direction.
+                                                    Table_t   m_table;
+
+                                                              /// @brief Number of threads that share out the levels.
+                                                std::size_t   m_threads;
+
+            static                                  Table_t   makeTable(const Language_t, const Direction_t, const std::vector<int>&, const Isa_t);
+
+        public:
+                                                              BulkTransformer_t(const Language_t, const Direction_t, const std::vector<int>&, const Isa_t= automaticIsa, const std::size_t= 1);
+                                                              BulkTransformer_t(const BulkTransformer_t&)              = delete;
+                                                              BulkTransformer_t(      BulkTransformer_t&&)             = delete;
+                                                             ~BulkTransformer_t()                                      = default;
+                                         BulkTransformer_t&   operator=(const BulkTransformer_t&)                      = delete;
+                                         BulkTransformer_t&   operator=(      BulkTransformer_t&&)                     = delete;
+                                                       void   run(const std::string_view, const LevelOutput_t&) const;
+    };
+
+} // namespace SherpadCaesar
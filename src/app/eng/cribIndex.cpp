@@ -0,0 +1,460 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utf8.hpp"
+#include "cribIndex.hpp"
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief Start of the index. The sizes of the other parts follow from it.
+struct CribIndex_t::Header_t{
+                                                              /// @brief CRIB_INDEX_MAGIC, padded with zeros.
+                                                       char   magic[16]           { };
+
+                                                              /// @brief Language of the alphabet of the fingerprints.
+                                              std::uint32_t   language            { 0 };
+
+                                                              /// @brief Letters of every fingerprint.
+                                              std::uint32_t   gramLetters         { 0 };
+
+                                                              /// @brief Number of files.
+                                              std::uint64_t   numFiles            { 0 };
+
+                                                              /// @brief Number of possible fingerprints.
+                                              std::uint64_t   numKeys             { 0 };
+
+                                                              /// @brief Number of files in all the lists of the fingerprints.
+                                              std::uint64_t   numPostings         { 0 };
+
+                                                              /// @brief Size of all the paths in bytes.
+                                              std::uint64_t   pathsSize           { 0 };
+};
+
+/// @brief A file of the index.
+struct CribIndex_t::File_t{
+                                                              /// @brief Size of the file in bytes when it was indexed.
+                                              std::uint64_t   size                { 0 };
+
+                                                              /// @brief Time of the last modification when it was indexed, in nanoseconds since the epoch.
+                                               std::int64_t   modified            { 0 };
+
+                                                              /// @brief Where its absolute path starts in the paths.
+                                              std::uint64_t   pathOffset          { 0 };
+
+                                                              /// @brief Size of its path in bytes.
+                                              std::uint64_t   pathLength          { 0 };
+};
+
+///==============================================================================
+/// @brief Calculates the number of possible fingerprints of an alphabet: every
+///        distance between two letters of a fingerprint is a digit.
+/// @param numLetters Number of letters of the alphabet.
+/// @return The number of fingerprints.
+///==============================================================================
+static std::uint64_t
+getNumKeys(const int numLetters) noexcept{
+
+    std::uint64_t numKeys { 1 };
+
+    for (int i= 1; i < CRIB_INDEX_GRAM_LETTERS; i++)
+       numKeys*= static_cast<std::uint64_t>(numLetters);
+
+    return numKeys;
+}
+
+///==============================================================================
+/// @brief Gets the size and modification time of a file.
+/// @param path Path of the file.
+/// @param size Where the size is stored.
+/// @param modified Where the time is stored.
+/// @return true whether it is a regular file. If it isn't, errno tells why, or
+///         is 0 if it exists.
+///==============================================================================
+static bool
+getStatus(const std::string& path, std::uint64_t& size, std::int64_t& modified) noexcept{
+
+    struct stat status { };
+
+    if (::stat(path.c_str(), &status) != 0)
+       return false;
+
+    if (!S_ISREG(status.st_mode)){
+       errno= 0;
+       return false;
+    }
+
+    size    = static_cast<std::uint64_t>(status.st_size);
+    modified= static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1'000'000'000 + status.st_mtim.tv_nsec;
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Constructor of the CribIndex_t class. Maps an index and checks that
+///        its parts fit in it.
+/// @param path Path of the index.
+///==============================================================================
+CribIndex_t::CribIndex_t(const std::string_view path)
+    : m_file { path } {
+
+    const std::string_view content { m_file.getContent() };
+
+    if (content.size() < sizeof(Header_t) || reinterpret_cast<std::uintptr_t>(content.data()) % alignof(Header_t) != 0)
+       throw CaesarException_t(EXCEPTION_23);
+
+    m_header= reinterpret_cast<const Header_t*>(content.data());
+
+    const std::string_view magic     { m_header->magic, ::strnlen(m_header->magic, sizeof(m_header->magic)) };
+    const bool             isEnglish { m_header->language == englishLanguage };
+    const bool             isSpanish { m_header->language == spanishLanguage };
+
+    if (magic != CRIB_INDEX_MAGIC || (!isEnglish && !isSpanish) || m_header->gramLetters != CRIB_INDEX_GRAM_LETTERS ||
+        m_header->numKeys != getNumKeys(LetterPositions_t { static_cast<Language_t>(m_header->language) }.getNumLetters()))
+       throw CaesarException_t(EXCEPTION_23);
+
+    //The counts come from the file, so they are checked one by one before they are multiplied.
+    const std::uint64_t available { content.size() - sizeof(Header_t) };
+
+    if (m_header->numFiles > available / sizeof(File_t) || m_header->numPostings > available / sizeof(std::uint32_t) || m_header->pathsSize > available ||
+        sizeof(Header_t) + (m_header->numKeys + 1) * sizeof(std::uint64_t) + m_header->numFiles * sizeof(File_t) +
+        m_header->numPostings * sizeof(std::uint32_t) + m_header->pathsSize != content.size())
+       throw CaesarException_t(EXCEPTION_23);
+
+    m_keyStarts= reinterpret_cast<const std::uint64_t*>(content.data() + sizeof(Header_t));
+    m_files    = reinterpret_cast<const File_t*>(m_keyStarts + m_header->numKeys + 1);
+    m_postings = reinterpret_cast<const std::uint32_t*>(m_files + m_header->numFiles);
+    m_paths    = reinterpret_cast<const char*>(m_postings + m_header->numPostings);
+
+    if (m_keyStarts[0] != 0 || m_keyStarts[m_header->numKeys] != m_header->numPostings)
+       throw CaesarException_t(EXCEPTION_23);
+
+    for (std::uint64_t key= 0; key < m_header->numKeys; key++)
+       if (m_keyStarts[key] > m_keyStarts[key + 1])
+          throw CaesarException_t(EXCEPTION_23);
+
+    for (std::uint64_t i= 0; i < m_header->numFiles; i++)
+       if (m_files[i].pathOffset > m_header->pathsSize || m_files[i].pathLength > m_header->pathsSize - m_files[i].pathOffset)
+          throw CaesarException_t(EXCEPTION_23);
+}
+
+///==============================================================================
+/// @brief Finds the fingerprints of a text. A fingerprint is the distances
+///        between CRIB_INDEX_GRAM_LETTERS consecutive letters, as the digits of
+///        a number; the characters that aren't letters are skipped, like the
+///        crib searcher does.
+/// @param text Text to fingerprint.
+/// @param letters Positions of the letters of the alphabet.
+/// @param seen Bitmap of the fingerprints already found. It is sized here and
+///        left clean, so it can be reused.
+/// @param keys Where the fingerprints are stored, sorted and without
+///        repetitions.
+///==============================================================================
+void
+CribIndex_t::collectKeys(const std::string_view text, const LetterPositions_t& letters, std::vector<std::uint64_t>& seen, std::vector<std::uint32_t>& keys){
+
+    const int           numLetters  { letters.getNumLetters() };
+    const std::uint64_t numKeys     { getNumKeys(numLetters) };
+          std::uint64_t key         { 0 };
+          int           numLetter   { 0 };
+          int           lastPosition{ -1 };
+          char32_t      codePoint   { 0 };
+
+    seen.resize((numKeys + 63) / 64, 0);
+    keys.clear();
+
+    for (std::size_t i= 0; i < text.size(); ){
+       const unsigned char byte     { static_cast<unsigned char>(text[i]) };
+             int           position { -1 };
+
+       //Most of the characters are ASCII, and most of the rest can't be letters.
+       if (byte < 0x80){
+          position= letters.getPosition(byte);
+          i++;
+       }
+       else{
+          i+= decodeUTF8Character(text.data(), text.size(), i, codePoint);
+          position= letters.getPosition(codePoint);
+       }
+
+       if (position < 0)
+          continue;
+
+       if (lastPosition >= 0){
+          key= (key * numLetters + static_cast<std::uint64_t>((position - lastPosition + numLetters) % numLetters)) % numKeys;
+
+          if (++numLetter >= CRIB_INDEX_GRAM_LETTERS - 1)
+             seen[key / 64]|= std::uint64_t { 1 } << (key % 64);
+       }
+
+       lastPosition= position;
+    }
+
+    for (std::size_t word= 0; word < seen.size(); word++){
+       for (std::uint64_t bits { seen[word] }; bits != 0; bits&= bits - 1)
+          keys.push_back(static_cast<std::uint32_t>(word * 64 + static_cast<std::size_t>(__builtin_ctzll(bits))));
+
+       seen[word]= 0;
+    }
+}
+
+///==============================================================================
+/// @brief Builds the index of some files and writes it. The files are read and
+///        fingerprinted in parallel; a file that fails is reported and left out
+///        of the index. The index is written to a temporary file that then
+///        replaces the old one, so an interrupted build doesn't damage it.
+/// @param language Language of the alphabet of the fingerprints.
+/// @param paths Paths of the files to index.
+/// @param indexPath Path of the index.
+/// @param threads Number of threads. If it is 0, one per hardware thread.
+/// @return How many files were indexed, and the errors.
+///==============================================================================
+IndexResult_t
+CribIndex_t::build(const Language_t language, const std::vector<std::string>& paths, const std::string_view indexPath, const std::size_t threads){
+
+    //A file of the collection, once it is fingerprinted.
+    struct Entry_t{
+                                                std::string   path                { };
+                                                std::string   error               { };
+                                                     File_t   file                { };
+                                  std::vector<std::uint32_t>  keys                { };
+    };
+
+    const LetterPositions_t               letters { language };
+          Header_t                        header  { };
+          std::vector<Entry_t>            entries ( paths.size() );
+          std::vector<std::uint64_t>      starts  ( getNumKeys(letters.getNumLetters()) + 1, 0 );
+          std::vector<std::uint32_t>      postings{ };
+          std::vector<File_t>             files   { };
+          std::string                     names   { };
+          IndexResult_t                   result  { };
+
+    {
+       WorkerPool_t                   pool  { threads > 0 ? threads : getDefaultThreads() };
+       std::vector<std::future<void>> tasks { };
+
+       tasks.reserve(entries.size());
+
+       for (std::size_t i= 0; i < entries.size(); i++){
+          tasks.push_back(pool.submit([&letters, &path = paths[i], &entry = entries[i]](){
+             std::error_code            eCode;
+             std::vector<std::uint64_t> seen { };
+
+             const std::filesystem::path absolute { std::filesystem::absolute(path, eCode) };
+
+             entry.path= eCode ? path : absolute.lexically_normal().string();
+
+             //The paths of the index end at their size, but they are written to lists where a line is a path.
+             if (eCode || entry.path.find('\n') != std::string::npos){
+                entry.error= eCode ? eCode.message() : "The path has a line break.";
+                return;
+             }
+
+             if (!getStatus(entry.path, entry.file.size, entry.file.modified)){
+                entry.error= errno != 0 ? std::strerror(errno) : "This isn't a regular file.";
+                return;
+             }
+
+             const MappedFile_t input { entry.path };
+
+             collectKeys(input.getContent(), letters, seen, entry.keys);
+          }));
+       }
+
+       for (std::size_t i= 0; i < tasks.size(); i++){
+          try{
+             tasks[i].get();
+          }
+          catch (const std::exception& e){
+             entries[i].error= e.what();
+          }
+       }
+    }
+
+    //The lists are filled in the order of the files, so every list is sorted.
+    for (const Entry_t& entry : entries)
+       if (entry.error.empty())
+          for (const std::uint32_t key : entry.keys)
+             starts[key + 1]++;
+
+    for (std::size_t key= 1; key < starts.size(); key++)
+       starts[key]+= starts[key - 1];
+
+    postings.resize(starts.back());
+
+    std::vector<std::uint64_t> next { starts.begin(), starts.end() - 1 };
+
+    for (Entry_t& entry : entries){
+       if (!entry.error.empty()){
+          result.failed.push_back(BatchResult_t { std::move(entry.path), std::move(entry.error) });
+          continue;
+       }
+
+       for (const std::uint32_t key : entry.keys)
+          postings[next[key]++]= static_cast<std::uint32_t>(files.size());
+
+       entry.file.pathOffset= names.size();
+       entry.file.pathLength= entry.path.size();
+       names.append(entry.path);
+       files.push_back(entry.file);
+       std::vector<std::uint32_t> { }.swap(entry.keys);
+    }
+
+    result.indexed= files.size();
+
+    std::memcpy(header.magic, CRIB_INDEX_MAGIC.data(), CRIB_INDEX_MAGIC.size());
+    header.language   = static_cast<std::uint32_t>(language);
+    header.gramLetters= CRIB_INDEX_GRAM_LETTERS;
+    header.numFiles   = files.size();
+    header.numKeys    = starts.size() - 1;
+    header.numPostings= postings.size();
+    header.pathsSize  = names.size();
+
+    //A unique name in the directory of the index, so the rename is atomic and two builds don't write the same file.
+    std::string temporaryPath  { std::string { indexPath } + ".XXXXXX" };
+    const int   fileDescriptor { ::mkstemp(temporaryPath.data()) };
+
+    if (fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_24);
+
+    {
+       //mkstemp(3) leaves the file only for its owner; the index gets the permissions of any other new file.
+       const mode_t mask { ::umask(0) };
+
+       ::umask(mask);
+       ::fchmod(fileDescriptor, 0666 & ~mask);
+
+       std::FILE* output { ::fdopen(fileDescriptor, "wb") };
+
+       if (output == nullptr){
+          ::close(fileDescriptor);
+          std::remove(temporaryPath.c_str());
+          throw CaesarException_t(EXCEPTION_24);
+       }
+
+//==============================================================================
+//                         LAMBDA writePart
+//==============================================================================
+       auto writePart= [output](const void* data, const std::size_t size){
+           return std::fwrite(data, 1, size, output) == size;
+       };
+
+       bool isWritten { writePart(&header, sizeof(header)) &&
+                        writePart(starts.data(), starts.size() * sizeof(std::uint64_t)) &&
+                        writePart(files.data(), files.size() * sizeof(File_t)) &&
+                        writePart(postings.data(), postings.size() * sizeof(std::uint32_t)) &&
+                        writePart(names.data(), names.size()) };
+
+       isWritten= std::fclose(output) == 0 && isWritten;
+
+       if (!isWritten){
+          std::remove(temporaryPath.c_str());
+          throw CaesarException_t(EXCEPTION_24);
+       }
+    }
+
+    if (std::rename(temporaryPath.c_str(), std::string { indexPath }.c_str()) != 0){
+       std::remove(temporaryPath.c_str());
+       throw CaesarException_t(EXCEPTION_24);
+    }
+
+    return result;
+}
+
+///==============================================================================
+/// @brief Gets the language of the alphabet of the fingerprints.
+/// @return The language of the index.
+///==============================================================================
+Language_t
+CribIndex_t::getLanguage() const noexcept{
+
+    return static_cast<Language_t>(m_header->language);
+}
+
+///==============================================================================
+/// @brief Gets the number of files of the index.
+/// @return The number of files.
+///==============================================================================
+std::size_t
+CribIndex_t::getNumFiles() const noexcept{
+
+    return static_cast<std::size_t>(m_header->numFiles);
+}
+
+///==============================================================================
+/// @brief Gets the path of a file of the index.
+/// @param file Number of the file.
+/// @return The absolute path of the file.
+///==============================================================================
+std::string
+CribIndex_t::getPath(const std::size_t file) const{
+
+    return std::string { m_paths + m_files[file].pathOffset, static_cast<std::size_t>(m_files[file].pathLength) };
+}
+
+///==============================================================================
+/// @brief Finds the files that can contain a crib at some level: those that
+///        have every fingerprint of the crib. The lists are intersected from
+///        the shortest one. A crib with fewer letters than a fingerprint can be
+///        anywhere, and so can the files changed since the index was built.
+/// @param crib Known piece of the plaintext.
+/// @return The paths of the files, in the order of the index.
+///==============================================================================
+std::vector<std::string>
+CribIndex_t::findCandidates(const std::string_view crib) const{
+
+    const LetterPositions_t          letters    { getLanguage() };
+          std::vector<std::uint64_t> seen       { };
+          std::vector<std::uint32_t> keys       { };
+          std::vector<std::uint32_t> candidates { };
+          std::vector<bool>          isCandidate( getNumFiles(), false );
+          std::vector<std::string>   paths      { };
+
+    collectKeys(crib, letters, seen, keys);
+
+    if (keys.empty())
+       isCandidate.assign(getNumFiles(), true);
+    else{
+       std::sort(keys.begin(), keys.end(), [this](const std::uint32_t a, const std::uint32_t b){
+          return m_keyStarts[a + 1] - m_keyStarts[a] < m_keyStarts[b + 1] - m_keyStarts[b];
+       });
+
+       candidates.assign(m_postings + m_keyStarts[keys.front()], m_postings + m_keyStarts[keys.front() + 1]);
+
+       for (std::size_t i= 1; i < keys.size() && !candidates.empty(); i++){
+          const std::uint32_t* first { m_postings + m_keyStarts[keys[i]] };
+          const std::uint32_t* last  { m_postings + m_keyStarts[keys[i] + 1] };
+
+          candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [first, last](const std::uint32_t file){
+             return !std::binary_search(first, last, file);
+          }), candidates.end());
+       }
+
+       for (const std::uint32_t file : candidates)
+          if (file < isCandidate.size())
+             isCandidate[file]= true;
+    }
+
+    for (std::size_t file= 0; file < getNumFiles(); file++){
+       const std::string   path     { getPath(file) };
+             std::uint64_t size     { 0 };
+             std::int64_t  modified { 0 };
+
+       //A file that can't be read anymore is searched too, so its error is reported.
+       if (isCandidate[file] || !getStatus(path, size, modified) || size != m_files[file].size || modified != m_files[file].modified)
+          paths.push_back(path);
+    }
+
+    return paths;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../dat/utils/utils.hpp"
+#include "../io/mappedFile.hpp"
+#include "batchTransformer.hpp"
+#include "letterPositions.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Result of building an index.
+struct IndexResult_t{
+                                                              /// @brief Number of files indexed.
+                                                std::size_t   indexed             { 0 };
+
+                                                              /// @brief Files that couldn't be indexed, and why.
+                                 std::vector<BatchResult_t>   failed              { };
+};
+
+/// @class CribIndex_t
+/// @brief Finds which files of a collection can contain a crib encrypted at any level, without reading them. Every run
+///        of CRIB_INDEX_GRAM_LETTERS letters of a file is fingerprinted by the distances between its letters, which no
+///        level changes, and the index keeps the files of every fingerprint. The index is a single file meant to be
+///        mapped in memory: a header, where the files of every fingerprint start, the files and the lists of files,
+///        all with a fixed layout, so a query only touches the lists of the fingerprints of the crib. The files that
+///        changed since the index was built are always candidates.
+
+    class CribIndex_t{
+        private:
+            struct Header_t;
+            struct File_t;
+
+                                                              /// @brief Index mapped in memory.
+                                               MappedFile_t   m_file;
+
+                                                              /// @brief Header of the index.
+                                            const Header_t*   m_header            { nullptr };
+
+                                                              /// @brief Where the list of files of every fingerprint starts, and where the last one ends.
+                                       const std::uint64_t*   m_keyStarts         { nullptr };
+
+                                                              /// @brief Files of the index.
+                                              const File_t*   m_files             { nullptr };
+
+                                                              /// @brief Lists of files of every fingerprint, one after another.
+                                       const std::uint32_t*   m_postings          { nullptr };
+
+                                                              /// @brief Paths of the files, one after another.
+                                                const char*   m_paths             { nullptr };
+
+            static                                     void   collectKeys(const std::string_view, const LetterPositions_t&, std::vector<std::uint64_t>&, std::vector<std::uint32_t>&);
+                                                std::string   getPath(const std::size_t)               const;
+
+        public:
+                explicit                                      CribIndex_t(const std::string_view);
+                                                              CribIndex_t(const CribIndex_t&)                  = delete;
+                                                              CribIndex_t(      CribIndex_t&&)                 = delete;
+                                                             ~CribIndex_t()                                    = default;
+                                                CribIndex_t&  operator=(const CribIndex_t&)                    = delete;
+                                                CribIndex_t&  operator=(      CribIndex_t&&)                   = delete;
+            static                            IndexResult_t   build(const Language_t, const std::vector<std::string>&, const std::string_view, const std::size_t= 0);
+                                                 Language_t   getLanguage()                            const noexcept;
+                                                std::size_t   getNumFiles()                            const noexcept;
+                                   std::vector<std::string>   findCandidates(const std::string_view)   const;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include "../dat/utils/utf8.hpp"
+#include "cribSearcher.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief Token of the first letter of the text, which has no letter before it. No distance is equal to it.
+constexpr std::int32_t FIRST_LETTER_TOKEN { 1 << 30 };
+
+///==============================================================================
+/// @brief Constructor of the CribSearcher_t class. Encodes the crib and builds
+///        the table of the search.
+/// @param language Language whose levels are searched.
+/// @param crib Known piece of the plaintext.
+///==============================================================================
+CribSearcher_t::CribSearcher_t(const Language_t language, const std::string_view crib)
+    : m_letters { language } {
+
+    int       lastPosition { -1 };
+    char32_t  codePoint    { 0 };
+
+    for (std::size_t i= 0; i < crib.size(); ){
+       i+= decodeUTF8Character(crib.data(), crib.size(), i, codePoint);
+
+       const int          position { m_letters.getPosition(codePoint) };
+       const std::int32_t token    { encode(codePoint, position, lastPosition) };
+
+       if (m_firstPosition < 0 && position >= 0)
+          m_firstPosition= position;
+       else if (m_firstPosition < 0)
+          m_prefix.push_back(token);
+       else
+          m_pattern.push_back(token);
+    }
+
+    m_window.resize(m_prefix.size() + 1 + m_pattern.size());
+    m_failure.resize(m_pattern.size(), 0);
+
+    for (std::size_t i= 1, matched= 0; i < m_pattern.size(); i++){
+       while (matched > 0 && m_pattern[i] != m_pattern[matched])
+          matched= m_failure[matched - 1];
+
+       if (m_pattern[i] == m_pattern[matched])
+          matched++;
+
+       m_failure[i]= matched;
+    }
+}
+
+///==============================================================================
+/// @brief Encodes a character. A letter is its distance in the alphabet to the
+///        letter before it and any other character is itself, as a negative
+///        number.
+/// @param codePoint Character to encode.
+/// @param position Position of the character in the alphabet. -1 if it isn't
+///        a letter.
+/// @param lastPosition Position of the letter before it. It is updated if the
+///        character is a letter.
+/// @return The token of the character.
+///==============================================================================
+std::int32_t
+CribSearcher_t::encode(const char32_t codePoint, const int position, int& lastPosition) const noexcept{
+
+    if (position < 0)
+       return -1 - static_cast<std::int32_t>(codePoint);
+
+    const int          numLetters { m_letters.getNumLetters() };
+    const std::int32_t token      { lastPosition < 0 ? FIRST_LETTER_TOKEN : (position - lastPosition + numLetters) % numLetters };
+
+    lastPosition= position;
+
+    return token;
+}
+
+///==============================================================================
+/// @brief Indicates whether the crib can be searched: it needs two letters at
+///        least, so the distances tell something about the level.
+/// @return true whether the crib has two letters or more.
+///==============================================================================
+bool
+CribSearcher_t::isValid() const noexcept{
+
+    for (const std::int32_t token : m_pattern)
+       if (token >= 0)
+          return true;
+
+    return false;
+}
+
+///==============================================================================
+/// @brief Searches the crib in the next piece of the text. The matches that
+///        started in earlier pieces are found as well.
+/// @param text Next piece of the text. It must not cut a UTF-8 character.
+/// @param matches Where the matches are added, in the order of the text. The
+///        matches of the level 0, where the text is the crib itself, aren't
+///        added.
+///==============================================================================
+void
+CribSearcher_t::add(const std::string_view text, std::vector<CribMatch_t>& matches){
+
+    const std::size_t windowSize { m_window.size() };
+          char32_t    codePoint  { 0 };
+
+    for (std::size_t i= 0; i < text.size(); ){
+       const int          length   { decodeUTF8Character(text.data(), text.size(), i, codePoint) };
+       const int          position { m_letters.getPosition(codePoint) };
+       const std::int32_t token    { encode(codePoint, position, m_lastPosition) };
+
+       m_window[m_numCharacters % windowSize]= Character_t { token, position, m_numBytes + i };
+       m_numCharacters++;
+       i+= static_cast<std::size_t>(length);
+
+       while (m_state > 0 && m_pattern[m_state] != token)
+          m_state= m_failure[m_state - 1];
+
+       if (m_pattern[m_state] == token)
+          m_state++;
+
+       if (m_state < m_pattern.size())
+          continue;
+
+       m_state= m_failure[m_state - 1];
+
+       //The pattern is matched: the first letter and the characters before it are checked apart.
+       if (m_numCharacters < windowSize)
+          continue;
+
+       const std::uint64_t start { m_numCharacters - windowSize };
+             bool          isMatch { true };
+
+       for (std::size_t j= 0; isMatch && j < m_prefix.size(); j++)
+          isMatch= m_window[(start + j) % windowSize].token == m_prefix[j];
+
+       const Character_t& first { m_window[(start + m_prefix.size()) % windowSize] };
+
+       if (!isMatch || first.position < 0)
+          continue;
+
+       const int level { (first.position - m_firstPosition + m_letters.getNumLetters()) % m_letters.getNumLetters() };
+
+       if (level != 0)
+          matches.push_back(CribMatch_t { level, m_window[start % windowSize].offset });
+    }
+
+    m_numBytes+= text.size();
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "../dat/utils/utils.hpp"
+#include "letterPositions.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Place of the text where the crib was found encrypted.
+struct CribMatch_t{
+                                                              /// @brief Level that decrypts the text there into the crib.
+                                                        int   level               { 0 };
+
+                                                              /// @brief Position of the first byte of the match in the text.
+                                              std::uint64_t   offset              { 0 };
+};
+
+/// @class CribSearcher_t
+/// @brief Finds a known piece of the plaintext, the crib, encrypted at any level of a language in a single pass over
+///        the text. Every letter is encoded as its distance in the alphabet to the letter before it, which no level
+///        changes, and every other character as itself, so a single Knuth-Morris-Pratt search over the encoded text
+///        finds the crib at every level at once; the level of a match is the distance between its first letter and
+///        the first letter of the crib. The letters match regardless of their case. The text can be given in pieces
+///        that don't cut a UTF-8 character.
+
+    class CribSearcher_t{
+        private:
+                                                              /// @brief A character of the text that can still be part of a match.
+            struct Character_t{
+                                                              /// @brief Character encoded like the crib.
+                                               std::int32_t   token               { 0 };
+
+                                                              /// @brief Position in the alphabet. -1 if it isn't a letter.
+                                                        int   position            { -1 };
+
+                                                              /// @brief Position of its first byte in the text.
+                                              std::uint64_t   offset              { 0 };
+            };
+
+                                                              /// @brief Positions of the letters in the alphabet.
+                                          LetterPositions_t   m_letters;
+
+                                                              /// @brief Characters of the crib before its first letter. They can't be letters.
+                                  std::vector<std::int32_t>   m_prefix            { };
+
+                                                              /// @brief Characters of the crib after its first letter, searched with KMP.
+                                  std::vector<std::int32_t>   m_pattern           { };
+
+                                                              /// @brief Longest proper prefix of the pattern that ends at every position of it.
+                                   std::vector<std::size_t>   m_failure           { };
+
+                                                              /// @brief Position in the alphabet of the first letter of the crib.
+                                                        int   m_firstPosition     { -1 };
+
+                                                              /// @brief Last characters of the text, as many as the crib has.
+                                   std::vector<Character_t>   m_window            { };
+
+                                                              /// @brief Characters and bytes of the text already searched.
+                                              std::uint64_t   m_numCharacters     { 0 };
+                                              std::uint64_t   m_numBytes          { 0 };
+
+                                                              /// @brief Position in the alphabet of the last letter of the text. -1 if there isn't any.
+                                                        int   m_lastPosition      { -1 };
+
+                                                              /// @brief Characters of the pattern matched by the end of the text.
+                                                std::size_t   m_state             { 0 };
+
+                                               std::int32_t   encode(const char32_t, const int, int&)  const noexcept;
+
+        public:
+                                                              CribSearcher_t(const Language_t, const std::string_view);
+                                                              CribSearcher_t(const CribSearcher_t&)            = default;
+                                                              CribSearcher_t(      CribSearcher_t&&)           = default;
+                                                             ~CribSearcher_t()                                 = default;
+                                            CribSearcher_t&   operator=(const CribSearcher_t&)                 = default;
+                                            CribSearcher_t&   operator=(      CribSearcher_t&&)                = default;
+                                                       bool   isValid()                                  const noexcept;
+                                                       void   add(const std::string_view, std::vector<CribMatch_t>&);
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <sys/stat.h>
+#include <unordered_set>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/hash.hpp"
+#include "../dat/utils/utils.hpp"
+#include "../io/mappedFile.hpp"
+#include "../io/mirrorManifest.hpp"
+#include "directoryMirror.hpp"
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+/// @brief A regular file of the source directory.
+struct SourceFile_t{
+                                                              /// @brief Path of the file relative to the source directory.
+                                                std::string   relativePath        { };
+
+                                                              /// @brief Size and modification time of the file. The hash is only known once it is read.
+                                            ManifestEntry_t   entry               { };
+};
+
+///==============================================================================
+/// @brief Lists the regular files of the source directory and creates its
+///        subdirectories in the output directory. The output directory is
+///        skipped if it is inside the source directory, and so are the links
+///        to directories.
+/// @param source Source directory.
+/// @param target Output directory.
+/// @return The files of the source directory.
+///==============================================================================
+static std::vector<SourceFile_t>
+listSourceFiles(const std::filesystem::path& source, const std::filesystem::path& target){
+
+    std::vector<SourceFile_t>                     files    { };
+    std::error_code                               eCode;
+    std::filesystem::recursive_directory_iterator iterator { source, eCode };
+
+    for (; !eCode && iterator != std::filesystem::recursive_directory_iterator { }; iterator.increment(eCode)){
+       const std::filesystem::directory_entry& entry        { *iterator };
+       const std::filesystem::path             relativePath { entry.path().lexically_relative(source) };
+             std::error_code                   typeCode;
+             struct stat                       status       { };
+
+       if (entry.is_directory(typeCode)){
+          if (entry.is_symlink(typeCode) || std::filesystem::equivalent(entry.path(), target, typeCode))
+             iterator.disable_recursion_pending();
+          else
+             //If it fails, its files fail when their output is opened.
+             std::filesystem::create_directories(target / relativePath, typeCode);
+       }
+       else if (entry.is_regular_file(typeCode) && ::stat(entry.path().c_str(), &status) == 0){
+          SourceFile_t file { };
+
+          file.relativePath  = relativePath.generic_string();
+          file.entry.size    = static_cast<std::uint64_t>(status.st_size);
+          file.entry.modified= static_cast<std::int64_t>(status.st_mtim.tv_sec) * 1'000'000'000 + status.st_mtim.tv_nsec;
+
+          files.push_back(std::move(file));
+       }
+    }
+
+    //A partial list would remove the outputs of the files that weren't listed.
+    if (eCode)
+       throw CaesarException_t(EXCEPTION_16);
+
+    return files;
+}
+
+///==============================================================================
+/// @brief Checks whether a path of the source directory is the one of the
+///        manifest, or of its temporary file, once it is in the output
+///        directory. Such a file can't be mirrored.
+/// @param relativePath Path relative to the source directory.
+/// @return true whether the path belongs to the manifest.
+///==============================================================================
+static bool
+isManifestPath(const std::string& relativePath) noexcept{
+
+    const std::filesystem::path path { std::filesystem::path { relativePath }.lexically_normal() };
+
+    return path == MIRROR_MANIFEST_NAME || path == std::string { MIRROR_MANIFEST_NAME } + ".tmp";
+}
+
+///==============================================================================
+/// @brief Constructor of the DirectoryMirror_t class.
+/// @param transformer Transformer of the language, level and direction.
+/// @param parameters Parameters of the transformation stored in the manifest.
+///        A manifest with other parameters makes every file be transformed.
+/// @param threads Number of threads. If it is 0, one per hardware thread.
+///==============================================================================
+DirectoryMirror_t::DirectoryMirror_t(const Transformer_t& transformer, const std::string_view parameters, const std::size_t threads)
+    : m_transformer { transformer }, m_parameters { parameters }, m_threads { threads > 0 ? threads : getDefaultThreads() } {
+
+}
+
+///==============================================================================
+/// @brief Brings the output directory up to date with the source directory.
+///        The files that aren't in the manifest, changed or lost their output
+///        are transformed; the outputs of the files that don't exist anymore
+///        are removed. The manifest is written at the end with the files that
+///        were transformed, so the ones that failed are tried again.
+/// @param source Source directory.
+/// @param target Output directory. It must exist.
+/// @return How many files were transformed, left or removed, and the errors.
+///==============================================================================
+MirrorResult_t
+DirectoryMirror_t::run(const std::string_view source, const std::string_view target) const{
+
+    const std::filesystem::path           sourceRoot   { source };
+    const std::filesystem::path           targetRoot   { target };
+    const std::string                     manifestPath { (targetRoot / MIRROR_MANIFEST_NAME).string() };
+          MirrorManifest_t                previous     { m_parameters };
+          MirrorManifest_t                current      { m_parameters };
+          MirrorResult_t                  result       { };
+          std::vector<SourceFile_t>       files        { listSourceFiles(sourceRoot, targetRoot) };
+          std::vector<std::size_t>        toHash       { };
+          std::vector<std::size_t>        toTransform  { };
+          std::unordered_set<std::string> present      { };
+
+    //With other parameters every file is transformed, but the previous files still tell which outputs to remove.
+    const bool isSameParameters { previous.load(manifestPath) };
+
+    present.reserve(files.size());
+
+    for (std::size_t i= 0; i < files.size(); i++){
+       const SourceFile_t&    file   { files[i] };
+       const ManifestEntry_t* known  { isSameParameters ? previous.find(file.relativePath) : nullptr };
+             struct stat      status { };
+
+       present.insert(file.relativePath);
+
+       //Its output would be overwritten by the manifest.
+       if (isManifestPath(file.relativePath)){
+          result.failed.push_back(BatchResult_t { (sourceRoot / file.relativePath).string(), "The name is reserved for the manifest of the mirror." });
+          continue;
+       }
+
+       if (known == nullptr || known->size != file.entry.size || ::stat((targetRoot / file.relativePath).c_str(), &status) != 0)
+          toTransform.push_back(i);
+       else if (known->modified == file.entry.modified){
+          current.set(file.relativePath, *known);
+          result.unchanged++;
+       }
+       else
+          toHash.push_back(i);
+    }
+
+    //The files only touched keep their output; their hash tells them apart from the changed ones.
+    if (!toHash.empty()){
+       std::vector<std::future<void>> tasks { };
+       WorkerPool_t                   pool  { m_threads };
+
+       tasks.reserve(toHash.size());
+
+       for (const std::size_t index : toHash){
+          tasks.push_back(pool.submit([&sourceRoot, &file = files[index]](){
+             const MappedFile_t     input   { (sourceRoot / file.relativePath).string() };
+             const std::string_view content { input.getContent() };
+
+             file.entry.hash= fnv1a(content.data(), content.size());
+          }));
+       }
+
+       for (std::size_t i= 0; i < toHash.size(); i++){
+          const SourceFile_t& file { files[toHash[i]] };
+
+          try{
+             tasks[i].get();
+          }
+          catch (const std::exception&){
+             //It is transformed, and its error is reported there.
+             toTransform.push_back(toHash[i]);
+             continue;
+          }
+
+          if (file.entry.hash == previous.find(file.relativePath)->hash){
+             current.set(file.relativePath, file.entry);
+             result.unchanged++;
+          }
+          else
+             toTransform.push_back(toHash[i]);
+       }
+    }
+
+    if (!toTransform.empty()){
+       const BatchTransformer_t       batch       { m_transformer, m_threads, true };
+             std::vector<std::string> inputPaths  { };
+             std::vector<std::string> outputPaths { };
+
+       inputPaths .reserve(toTransform.size());
+       outputPaths.reserve(toTransform.size());
+
+       for (const std::size_t index : toTransform){
+          inputPaths .push_back((sourceRoot / files[index].relativePath).string());
+          outputPaths.push_back((targetRoot / files[index].relativePath).string());
+       }
+
+       std::vector<BatchResult_t> results { batch.run(inputPaths, outputPaths) };
+
+       for (std::size_t i= 0; i < results.size(); i++){
+          SourceFile_t& file { files[toTransform[i]] };
+
+          if (results[i].error.empty()){
+             file.entry.hash= results[i].hash;
+             current.set(file.relativePath, file.entry);
+             result.transformed++;
+          }
+          else
+             result.failed.push_back(std::move(results[i]));
+       }
+    }
+
+    for (const auto& [relativePath, entry] : previous.getEntries()){
+       const std::filesystem::path path { std::filesystem::path { relativePath }.lexically_normal() };
+             std::error_code       eCode;
+
+       //A manifest edited by hand must not remove anything outside the output directory.
+       if (present.count(relativePath) > 0 || path.is_absolute() || path.empty() || *path.begin() == ".." || isManifestPath(relativePath))
+          continue;
+
+       if (std::filesystem::remove(targetRoot / path, eCode))
+          result.removed++;
+    }
+
+    current.save(manifestPath);
+
+    return result;
+}
+
+} // namespace SherpadCaesar
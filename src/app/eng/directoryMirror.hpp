@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "batchTransformer.hpp"
+#include "transformer.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Result of a run of a mirror.
+struct MirrorResult_t{
+                                                              /// @brief Files transformed because they were new or changed.
+                                                std::size_t   transformed         { 0 };
+
+                                                              /// @brief Files whose output was already up to date.
+                                                std::size_t   unchanged           { 0 };
+
+                                                              /// @brief Output files removed because their source file doesn't exist anymore.
+                                                std::size_t   removed             { 0 };
+
+                                                              /// @brief Files that couldn't be transformed. They are tried again the next time.
+                                 std::vector<BatchResult_t>   failed              { };
+};
+
+/// @class DirectoryMirror_t
+/// @brief Transforms a source directory into an output directory with the same tree, in parallel through a batch. A
+///        manifest in the output directory keeps the size, modification time and hash of every source file already
+///        transformed, so the next runs only transform the new and changed files. A file whose modification time
+///        changed but whose size didn't is hashed first, and it is only transformed if its content changed.
+
+    class DirectoryMirror_t{
+        private:
+                                                              /// @brief Transformer of the language, level and direction.
+                                              Transformer_t   m_transformer;
+
+                                                              /// @brief Parameters of the transformation stored in the manifest.
+                                                std::string   m_parameters;
+
+                                                              /// @brief Number of threads that hash and transform the files.
+                                                std::size_t   m_threads;
+
+        public:
+                                                              DirectoryMirror_t(const Transformer_t&, const std::string_view, const std::size_t= 1);
+                                                              DirectoryMirror_t(const DirectoryMirror_t&)              = delete;
+                                                              DirectoryMirror_t(      DirectoryMirror_t&&)             = delete;
+                                                             ~DirectoryMirror_t()                                      = default;
+                                         DirectoryMirror_t&   operator=(const DirectoryMirror_t&)                      = delete;
+                                         DirectoryMirror_t&   operator=(      DirectoryMirror_t&&)                     = delete;
+                                             MirrorResult_t   run(const std::string_view, const std::string_view)     const;
+    };
+
+} // namespace SherpadCaesar
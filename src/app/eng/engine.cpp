@@ -0,0 +1,164 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include "../dat/excep/caesarException.hpp"
+#include "engine.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Validates the parameters of an engine before its table is built. The
+///        table could be built for any positive level, but only these ones are
+///        a Caesar cipher of the alphabet.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param level Level of the transformation.
+/// @return The level.
+///==============================================================================
+static int
+validateParameters(const Language_t language, const Direction_t direction, const int level){
+
+    const int maxLevel { language == spanishLanguage ? MAX_LEVEL_SPANISH : MAX_LEVEL_ENGLISH };
+
+    if ((language != englishLanguage && language != spanishLanguage) || (direction != encryptDirection && direction != decryptDirection) ||
+        level < MIN_LEVEL || level > maxLevel)
+       throw CaesarException_t(EXCEPTION_25);
+
+    return level;
+}
+
+///==============================================================================
+/// @brief Constructor of the Engine_t class. Builds the translation table of
+///        the language, level and direction once.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param level Level of the transformation, from MIN_LEVEL to the maximum
+///        level of the language.
+/// @param isa Instruction set of the ASCII kernel.
+/// @param threads Number of threads of run() and runInto(). If it is 0, one
+///        per hardware thread.
+///==============================================================================
+Engine_t::Engine_t(const Language_t language, const Direction_t direction, const int level, const Isa_t isa, const std::size_t threads)
+    : m_language { language }, m_direction { direction }, m_level { validateParameters(language, direction, level) },
+      m_transformer { language, direction, level, isa, threads } {
+
+}
+
+///==============================================================================
+/// @brief Gets the language of the alphabets.
+/// @return m_language that contains the language.
+///==============================================================================
+Language_t
+Engine_t::getLanguage() const noexcept{
+
+    return m_language;
+}
+
+///==============================================================================
+/// @brief Gets the direction of the transformation.
+/// @return m_direction that contains the direction.
+///==============================================================================
+Direction_t
+Engine_t::getDirection() const noexcept{
+
+    return m_direction;
+}
+
+///==============================================================================
+/// @brief Gets the level of the transformation.
+/// @return m_level that contains the level.
+///==============================================================================
+int
+Engine_t::getLevel() const noexcept{
+
+    return m_level;
+}
+
+///==============================================================================
+/// @brief Gets the transformer, for the parts of the library that take one,
+///        such as the batches.
+/// @return m_transformer that contains the transformer.
+///==============================================================================
+const Transformer_t&
+Engine_t::getTransformer() const noexcept{
+
+    return m_transformer;
+}
+
+///==============================================================================
+/// @brief Gets the size of the buffer needed to transform a text.
+/// @param length Size of the text to transform in bytes.
+/// @return The number of bytes that the output buffer must have.
+///==============================================================================
+std::size_t
+Engine_t::getMaxOutputLength(const std::size_t length) const noexcept{
+
+    return m_transformer.getMaxOutputLength(length);
+}
+
+///==============================================================================
+/// @brief Indicates whether the output always has the size of the input, so a
+///        text can be transformed in place.
+/// @return true whether the alphabets are A-Z and a-z.
+///==============================================================================
+bool
+Engine_t::isLengthPreserving() const noexcept{
+
+    return m_transformer.isLengthPreserving();
+}
+
+///==============================================================================
+/// @brief Transforms a text in the calling thread, without allocating.
+/// @param input Text to transform.
+/// @param output Where the transformed text will be stored. It must have at
+///        least getMaxOutputLength(input.length()) bytes.
+/// @return The number of bytes written in the output.
+///==============================================================================
+std::size_t
+Engine_t::transform(const std::string_view input, char* output) const noexcept{
+
+    return m_transformer.transform(input.data(), input.length(), output);
+}
+
+///==============================================================================
+/// @brief Transforms a text over itself in the calling thread, without
+///        allocating. It is only possible when isLengthPreserving().
+/// @param text Text to transform.
+/// @param length Size of the text in bytes.
+/// @return true whether the text was transformed.
+///==============================================================================
+bool
+Engine_t::transformInPlace(char* text, const std::size_t length) const noexcept{
+
+    if (!m_transformer.isLengthPreserving())
+       return false;
+
+    m_transformer.transform(text, length, text);
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Transforms a text with the threads of the engine and writes it.
+/// @param input Text to transform.
+/// @param write Receives the transformed text piece by piece, in order.
+///==============================================================================
+void
+Engine_t::run(const std::string_view input, const std::function<void(const char*, const std::size_t)>& write) const{
+
+    m_transformer.run(input, write);
+}
+
+///==============================================================================
+/// @brief Transforms a text straight into its place in the output with the
+///        threads of the engine. Only valid when isLengthPreserving(); the
+///        output can be the input itself.
+/// @param input Text to transform.
+/// @param output Where the transformed text will be stored. It must have the
+///        size of the input.
+///==============================================================================
+void
+Engine_t::runInto(const std::string_view input, char* output) const{
+
+    m_transformer.runInto(input, output);
+}
+
+} // namespace SherpadCaesar
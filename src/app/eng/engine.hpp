@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include "../dat/utils/utils.hpp"
+#include "transformer.hpp"
+
+namespace SherpadCaesar{
+
+/// @class Engine_t
+/// @brief Entry point of libcaesar. An engine is built once per language, direction and level, and is immutable from
+///        then on, so a single engine can be shared by any number of threads. Its transform calls write into memory
+///        given by the caller and never allocate; run() and runInto() share out a big text between threads.
+
+    class Engine_t{
+        private:
+                                                              /// @brief Language of the alphabets.
+                                                 Language_t   m_language;
+
+                                                              /// @brief Direction of the transformation.
+                                                Direction_t   m_direction;
+
+                                                              /// @brief Level of the transformation.
+                                                        int   m_level;
+
+                                                              /// @brief Transformer of the language, level and direction.
+                                              Transformer_t   m_transformer;
+
+        public:
+                                                              Engine_t(const Language_t, const Direction_t, const int, const Isa_t= automaticIsa, const std::size_t= 1);
+                                                              Engine_t(const Engine_t&)                        = default;
+                                                              Engine_t(      Engine_t&&)                       = default;
+                                                             ~Engine_t()                                       = default;
+                                                  Engine_t&   operator=(const Engine_t&)                       = default;
+                                                  Engine_t&   operator=(      Engine_t&&)                      = default;
+                                                 Language_t   getLanguage()                            const noexcept;
+                                                Direction_t   getDirection()                           const noexcept;
+                                                        int   getLevel()                               const noexcept;
+                                        const Transformer_t&  getTransformer()                         const noexcept;
+                                                std::size_t   getMaxOutputLength(const std::size_t)    const noexcept;
+                                                       bool   isLengthPreserving()                     const noexcept;
+                                                std::size_t   transform(const std::string_view, char*) const noexcept;
+                                                       bool   transformInPlace(char*, const std::size_t) const noexcept;
+                                                       void   run(const std::string_view, const std::function<void(const char*, const std::size_t)>&) const;
+                                                       void   runInto(const std::string_view, char*)   const;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <limits>
+#include "frequencyAnalyzer.hpp"
+#include "languageTraits.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Counts the bytes of a piece of the text. A piece must not end in the
+///        middle of a UTF-8 character.
+/// @param text Piece of the text.
+///==============================================================================
+void
+FrequencyAnalyzer_t::add(const std::string_view text) noexcept{
+
+    const unsigned char* bytes          { reinterpret_cast<const unsigned char*>(text.data()) };
+    const std::size_t    size           { text.size() };
+          std::uint64_t  enyes          { 0 };
+          std::size_t    i              { 0 };
+    //Four tables, so consecutive equal bytes don't wait for each other's increment.
+          std::uint64_t  counts[4][256] { };
+
+    for (; i + 4 <= size; i+= 4){
+       counts[0][bytes[i]]++;
+       counts[1][bytes[i + 1]]++;
+       counts[2][bytes[i + 2]]++;
+       counts[3][bytes[i + 3]]++;
+    }
+
+    for (; i < size; i++)
+       counts[0][bytes[i]]++;
+
+    for (int byte= 0; byte < 256; byte++)
+       m_bytes[byte]+= counts[0][byte] + counts[1][byte] + counts[2][byte] + counts[3][byte];
+
+    //'ñ' is C3 B1 and 'Ñ' is C3 91. This loop has no branches, so it is vectorized.
+    for (std::size_t j= 1; j < size; j++)
+       enyes+= (bytes[j - 1] == 0xC3) & ((bytes[j] | 0x20) == 0xB1);
+
+    m_enyes+= enyes;
+}
+
+///==============================================================================
+/// @brief Scores every level of some languages.
+/// @param languages Languages whose levels are scored.
+/// @return The levels from the best to the worst. It is empty if the text has
+///         no letters.
+///==============================================================================
+std::vector<CrackCandidate_t>
+FrequencyAnalyzer_t::rank(const std::vector<Language_t>& languages) const{
+
+    std::vector<CrackCandidate_t> candidates { };
+
+    for (const Language_t language : languages){
+       if (language == englishLanguage)
+          rankLanguage<englishLanguage>(candidates);
+       else
+          rankLanguage<spanishLanguage>(candidates);
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const CrackCandidate_t& a, const CrackCandidate_t& b){
+       return a.score < b.score;
+    });
+
+    return candidates;
+}
+
+///==============================================================================
+/// @brief Calculates the frequencies of the letters of a language in the order
+///        of the alphabet of another one. A letter that the language doesn't
+///        use, like 'ñ' in English, gets a tiny frequency, so it is still
+///        possible but unlikely.
+/// @tparam L Language of the alphabet.
+/// @tparam F Language of the frequencies.
+/// @return The frequencies, adding up to 1.
+///==============================================================================
+template <Language_t L, Language_t F>
+static constexpr std::array<double, AlphabetProperties_t<L>::NUM_LETTERS>
+getFrequencies() noexcept{
+
+    constexpr double MIN_FREQUENCY { 0.001 };
+
+    std::array<double, AlphabetProperties_t<L>::NUM_LETTERS> frequencies { };
+    double                                                   sum         { 0.0 };
+
+    for (std::size_t i= 0; i < frequencies.size(); i++){
+       frequencies[i]= MIN_FREQUENCY;
+
+       for (std::size_t j= 0; j < LanguageTraits_t<F>::lowercase.size(); j++)
+          if (LanguageTraits_t<F>::lowercase[j] == LanguageTraits_t<L>::lowercase[i])
+             frequencies[i]= std::max(LanguageTraits_t<F>::frequencies[j], MIN_FREQUENCY);
+
+       sum+= frequencies[i];
+    }
+
+    for (double& frequency : frequencies)
+       frequency/= sum;
+
+    return frequencies;
+}
+
+///==============================================================================
+/// @brief Scores every level of the alphabet of a language. A letter of the
+///        text at position (i + level) of the alphabet is the letter i once
+///        decrypted, so the score of a level compares the counts rotated by
+///        the level with the counts expected from the letter frequencies. The
+///        text may be written in the other language, like an English text
+///        encrypted with the Spanish alphabet, so both frequencies are tried
+///        and the best fit is kept.
+/// @tparam L Language whose levels are scored.
+/// @param candidates Where the levels are added.
+///==============================================================================
+template <Language_t L>
+void
+FrequencyAnalyzer_t::rankLanguage(std::vector<CrackCandidate_t>& candidates) const{
+
+    using Traits_t= LanguageTraits_t<L>;
+
+    constexpr int NUM_LETTERS { AlphabetProperties_t<L>::NUM_LETTERS };
+
+    constexpr std::array<std::array<double, NUM_LETTERS>, 2> FREQUENCIES { getFrequencies<L, englishLanguage>(), getFrequencies<L, spanishLanguage>() };
+
+    std::array<double, NUM_LETTERS> letters { };
+    double                          total   { 0.0 };
+
+    for (int i= 0; i < NUM_LETTERS; i++){
+       const char32_t uppercase { Traits_t::uppercase[i] };
+       const char32_t lowercase { Traits_t::lowercase[i] };
+
+       //The only letter outside ASCII of the alphabets is 'ñ'.
+       if (uppercase < 0x80)
+          letters[i]= static_cast<double>(m_bytes[uppercase] + m_bytes[lowercase]);
+       else
+          letters[i]= static_cast<double>(m_enyes);
+
+       total+= letters[i];
+    }
+
+    if (total == 0.0)
+       return;
+
+    for (int level= MIN_LEVEL; level < NUM_LETTERS; level++){
+       CrackCandidate_t candidate { L, level, std::numeric_limits<double>::max() };
+
+       for (const std::array<double, NUM_LETTERS>& frequencies : FREQUENCIES){
+          double score { 0.0 };
+
+          for (int i= 0; i < NUM_LETTERS; i++){
+             const double expected   { total * frequencies[i] };
+             const double difference { letters[(i + level) % NUM_LETTERS] - expected };
+
+             score+= difference * difference / expected;
+          }
+
+          candidate.score= std::min(candidate.score, score);
+       }
+
+       candidates.push_back(candidate);
+    }
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "../dat/utils/utils.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Level that could decrypt a text, and how well its letters fit the language.
+struct CrackCandidate_t{
+                                                              /// @brief Language of the alphabet rotated by the level.
+                                                 Language_t   language            { englishLanguage };
+
+                                                              /// @brief Level of decryption.
+                                                        int   level               { 0 };
+
+                                                              /// @brief Chi-squared of the decrypted letters against the frequencies of the language. Lower is better.
+                                                     double   score               { 0.0 };
+};
+
+/// @class FrequencyAnalyzer_t
+/// @brief Finds the levels that most likely decrypt a text without decrypting it. The text is read once to count its
+///        bytes; the letters of a level are the same counts rotated, so every level of every language is scored by
+///        chi-squared against the frequencies of the language from those counts alone.
+
+    class FrequencyAnalyzer_t{
+        private:
+                                                              /// @brief Times that every byte appears in the text.
+                             std::array<std::uint64_t, 256>   m_bytes             { };
+
+                                                              /// @brief Times that 'ñ' or 'Ñ' appears in the text.
+                                              std::uint64_t   m_enyes             { 0 };
+
+            template <Language_t L>                    void   rankLanguage(std::vector<CrackCandidate_t>&) const;
+
+        public:
+                                                              FrequencyAnalyzer_t()                                    = default;
+                                                              FrequencyAnalyzer_t(const FrequencyAnalyzer_t&)          = default;
+                                                              FrequencyAnalyzer_t(      FrequencyAnalyzer_t&&)         = default;
+                                                             ~FrequencyAnalyzer_t()                                    = default;
+                                       FrequencyAnalyzer_t&   operator=(const FrequencyAnalyzer_t&)                    = default;
+                                       FrequencyAnalyzer_t&   operator=(      FrequencyAnalyzer_t&&)                   = default;
+                                                       void   add(const std::string_view)                      noexcept;
+                              std::vector<CrackCandidate_t>   rank(const std::vector<Language_t>&)       const;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include "../dat/utils/utils.hpp"
+
+namespace SherpadCaesar{
+
+/// @struct LanguageTraits_t
+/// @brief Alphabets of a language decoded at compile time from the constants of utils.hpp, and how often every letter
+///        appears in its texts, in percent and in the order of the alphabets.
+template <Language_t L>
+struct LanguageTraits_t;
+
+template <>
+struct LanguageTraits_t<englishLanguage>{
+    static constexpr auto uppercase { englishUppercaseCodePoints };
+    static constexpr auto lowercase { englishLowercaseCodePoints };
+
+    static constexpr std::array<double, MAX_LEVEL_ENGLISH + 1> frequencies {
+        8.167, 1.492, 2.782, 4.253, 12.702, 2.228, 2.015, 6.094, 6.966, 0.153, 0.772, 4.025, 2.406,
+        6.749, 7.507, 1.929, 0.095,  5.987, 6.327, 9.056, 2.758, 0.978, 2.360, 0.150, 1.974, 0.074
+    };
+};
+
+template <>
+struct LanguageTraits_t<spanishLanguage>{
+    static constexpr auto uppercase { spanishUppercaseCodePoints };
+    static constexpr auto lowercase { spanishLowercaseCodePoints };
+
+    static constexpr std::array<double, MAX_LEVEL_SPANISH + 1> frequencies {
+        11.525, 2.215, 4.019, 5.010, 12.181, 0.692, 1.768, 0.703, 6.247, 0.493, 0.011, 4.967, 3.157, 6.712,
+         0.311, 8.683, 2.510, 0.877,  6.871, 7.977, 4.632, 2.927, 1.138, 0.017, 0.215, 1.008, 0.467
+    };
+};
+
+/// @struct AlphabetProperties_t
+/// @brief Properties of the alphabets of a language calculated at compile time.
+template <Language_t L>
+struct AlphabetProperties_t{
+    using Traits_t= LanguageTraits_t<L>;
+
+    static_assert(Traits_t::uppercase.size() == Traits_t::lowercase.size(), "Both alphabets must have the same letters.");
+    static_assert(Traits_t::uppercase.size() == Traits_t::frequencies.size(), "Every letter must have its frequency.");
+
+                       /// @brief Number of letters of the alphabets.
+    static constexpr int         NUM_LETTERS        { static_cast<int>(Traits_t::uppercase.size()) };
+
+                       /// @brief Biggest code point of both alphabets.
+    static constexpr char32_t    MAX_CODE_POINT     { std::max(*std::max_element(Traits_t::uppercase.begin(), Traits_t::uppercase.end()),
+                                                               *std::max_element(Traits_t::lowercase.begin(), Traits_t::lowercase.end())) };
+
+                       /// @brief Number of bytes of the longest letter in UTF-8.
+    static constexpr int         MAX_LETTER_LENGTH  { MAX_CODE_POINT < 0x80 ? 1 : MAX_CODE_POINT < 0x800 ? 2 : MAX_CODE_POINT < 0x10000 ? 3 : 4 };
+
+                       /// @brief Maximum number of output bytes that a single input byte can produce.
+    static constexpr std::size_t EXPANSION          { static_cast<std::size_t>(MAX_LETTER_LENGTH) };
+
+                       /// @brief Indicates whether the alphabets are exactly A-Z and a-z, which the ASCII kernels can rotate.
+    static constexpr bool        IS_ASCII_ROTATION  { [](){
+        bool isRotation { NUM_LETTERS == 26 };
+
+        for (int i= 0; isRotation && i < NUM_LETTERS; i++)
+           isRotation= Traits_t::uppercase[i] == static_cast<char32_t>('A' + i) && Traits_t::lowercase[i] == static_cast<char32_t>('a' + i);
+
+        return isRotation;
+    }() };
+
+    ///==============================================================================
+    /// @brief Calculates the positions that every letter moves forward.
+    /// @tparam D Direction of the transformation.
+    /// @param currentLevel Level to perform the transformation. It is positive.
+    /// @return The shift, between 0 and NUM_LETTERS - 1.
+    ///==============================================================================
+    template <Direction_t D>
+    static constexpr int getShift(const int currentLevel) noexcept{
+
+        if constexpr (D == encryptDirection)
+           return currentLevel % NUM_LETTERS;
+        else
+           return (NUM_LETTERS - currentLevel % NUM_LETTERS) % NUM_LETTERS;
+    }
+};
+
+} // namespace SherpadCaesar
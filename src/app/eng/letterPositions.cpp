@@ -0,0 +1,43 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include "languageTraits.hpp"
+#include "letterPositions.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the LetterPositions_t class. Both cases of every letter
+///        get its position in the alphabet.
+/// @param language Language of the alphabet.
+///==============================================================================
+LetterPositions_t::LetterPositions_t(const Language_t language)
+    : m_numLetters { language == spanishLanguage ? AlphabetProperties_t<spanishLanguage>::NUM_LETTERS : AlphabetProperties_t<englishLanguage>::NUM_LETTERS } {
+
+//==============================================================================
+//                         LAMBDA loadPositions
+//==============================================================================
+    auto loadPositions= [this](const auto& uppercase, const auto& lowercase){
+        for (std::size_t i= 0; i < uppercase.size(); i++){
+           m_positions[uppercase[i]]= static_cast<int>(i);
+           m_positions[lowercase[i]]= static_cast<int>(i);
+        }
+    };
+
+    m_positions.fill(-1);
+
+    if (language == spanishLanguage)
+       loadPositions(LanguageTraits_t<spanishLanguage>::uppercase, LanguageTraits_t<spanishLanguage>::lowercase);
+    else
+       loadPositions(LanguageTraits_t<englishLanguage>::uppercase, LanguageTraits_t<englishLanguage>::lowercase);
+}
+
+///==============================================================================
+/// @brief Gets the number of letters of the alphabet.
+/// @return m_numLetters that contains the number of letters.
+///==============================================================================
+int
+LetterPositions_t::getNumLetters() const noexcept{
+
+    return m_numLetters;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include "../dat/utils/utils.hpp"
+
+namespace SherpadCaesar{
+
+/// @class LetterPositions_t
+/// @brief Finds the position in the alphabet of a language of any character, regardless of its case. Every letter of
+///        both alphabets is below 256, so a table of 256 positions answers without searching.
+
+    class LetterPositions_t{
+        private:
+                                                              /// @brief Number of letters of the alphabet.
+                                                        int   m_numLetters;
+
+                                                              /// @brief Position in the alphabet of every code point below 256. -1 if it isn't a letter.
+                                        std::array<int, 256>  m_positions         { };
+
+        public:
+                explicit                                      LetterPositions_t(const Language_t);
+                                                              LetterPositions_t(const LetterPositions_t&)      = default;
+                                                              LetterPositions_t(      LetterPositions_t&&)     = default;
+                                                             ~LetterPositions_t()                              = default;
+                                          LetterPositions_t&  operator=(const LetterPositions_t&)              = default;
+                                          LetterPositions_t&  operator=(      LetterPositions_t&&)             = default;
+                                                        int   getNumLetters()                          const noexcept;
+                                                        int   getPosition(const char32_t)              const noexcept;
+    };
+
+///==============================================================================
+/// @brief Gets the position of a character in the alphabet. It is defined here
+///        so it is inlined in the loops over every character of a text.
+/// @param codePoint Character to find.
+/// @return The position of the letter, or -1 if it isn't a letter.
+///==============================================================================
+inline int
+LetterPositions_t::getPosition(const char32_t codePoint) const noexcept{
+
+    return codePoint < m_positions.size() ? m_positions[codePoint] : -1;
+}
+
+} // namespace SherpadCaesar
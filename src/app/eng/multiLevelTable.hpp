@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include "../dat/utils/utf8.hpp"
+#include "asciiKernel.hpp"
+#include "languageTraits.hpp"
+
+namespace SherpadCaesar{
+
+/// @class MultiLevelTable_t
+/// @brief Transforms the same text at several levels. The text is decoded once into symbols (the ASCII byte itself, or
+///        the index of a non-ASCII letter), and every level then only looks its symbols up in its own table. With the
+///        English alphabets there is nothing to decode and every level runs the ASCII kernel over the same block.
+/// @tparam L Language of the alphabets.
+
+template <Language_t L>
+    class MultiLevelTable_t{
+        public:
+            /// @brief Decoded block: one symbol and one source length per character.
+            struct Symbols_t{
+                                                              /// @brief Symbol of every character. RAW_SYMBOL if it is copied as it is.
+                                  std::vector<std::uint8_t>   symbols             { };
+
+                                                              /// @brief Number of bytes of every character in the input.
+                                  std::vector<std::uint8_t>   lengths             { };
+
+                                                              /// @brief Number of decoded characters.
+                                                std::size_t   count               { 0 };
+            };
+
+        private:
+            using Properties_t= AlphabetProperties_t<L>;
+            using Traits_t    = LanguageTraits_t<L>;
+
+                                                              /// @brief Symbol of the characters that aren't letters and aren't ASCII.
+            static constexpr                   std::uint8_t   RAW_SYMBOL          { 0xFF };
+
+                                                              /// @brief Non-ASCII letters of both alphabets, in order. Their symbol is 0x80 plus their index here.
+            static constexpr auto WIDE_LETTERS { [](){
+                std::array<char32_t, 2 * Properties_t::NUM_LETTERS> letters { };
+                std::size_t                                          count   { 0 };
+
+                for (const char32_t codePoint : Traits_t::uppercase)
+                   if (codePoint >= 0x80)
+                      letters[count++]= codePoint;
+                for (const char32_t codePoint : Traits_t::lowercase)
+                   if (codePoint >= 0x80)
+                      letters[count++]= codePoint;
+
+                return std::pair { letters, count };
+            }() };
+
+                                                              /// @brief Number of symbols with a table entry.
+            static constexpr                    std::size_t   NUM_SYMBOLS         { 0x80 + WIDE_LETTERS.second };
+
+            static_assert(NUM_SYMBOLS <= RAW_SYMBOL, "Too many non-ASCII letters for one-byte symbols.");
+
+                                                              /// @brief Symbol of every code point up to the biggest one of the alphabets.
+            static constexpr auto SYMBOL_OF_CODE_POINT { [](){
+                std::array<std::uint8_t, Properties_t::MAX_CODE_POINT + 1> symbols { };
+
+                for (std::size_t i= 0; i < symbols.size(); i++)
+                   symbols[i]= (i < 0x80) ? static_cast<std::uint8_t>(i) : RAW_SYMBOL;
+                for (std::size_t i= 0; i < WIDE_LETTERS.second; i++)
+                   symbols[WIDE_LETTERS.first[i]]= static_cast<std::uint8_t>(0x80 + i);
+
+                return symbols;
+            }() };
+
+            /// @brief Transformed character of a symbol.
+            struct Entry_t{
+                                                              /// @brief UTF-8 bytes of the transformed character.
+                                                       char   bytes[UTF8_MAX_LENGTH]  { };
+
+                                                              /// @brief Number of bytes of the transformed character.
+                                              unsigned char   length                  { 0 };
+            };
+
+            using Table_t= std::array<Entry_t, NUM_SYMBOLS>;
+
+                                                              /// @brief Positions that every letter moves forward at each level.
+                                           std::vector<int>   m_shifts            { };
+
+                                                              /// @brief Table of every level. Empty when the ASCII kernel is used.
+                                       std::vector<Table_t>   m_tables            { };
+
+                                                              /// @brief Vectorized kernel used when the alphabets are A-Z and a-z.
+                                              AsciiKernel_t   m_asciiKernel       { nullptr };
+
+                                                              MultiLevelTable_t(std::vector<int>&&, const Isa_t);
+                                                       void   loadAlphabet(Table_t&, const std::array<char32_t, Properties_t::NUM_LETTERS>&, const int) noexcept;
+
+        public:
+                                                              MultiLevelTable_t(const MultiLevelTable_t&)              = default;
+                                                              MultiLevelTable_t(      MultiLevelTable_t&&)             = default;
+                                                             ~MultiLevelTable_t()                                      = default;
+                                         MultiLevelTable_t&   operator=(const MultiLevelTable_t&)                      = default;
+                                         MultiLevelTable_t&   operator=(      MultiLevelTable_t&&)                     = default;
+                      template <Direction_t D>
+                      static             MultiLevelTable_t    make(const std::vector<int>&, const Isa_t= automaticIsa);
+                      static constexpr          std::size_t   getMaxOutputLength(const std::size_t)                    noexcept;
+                                                std::size_t   getNumLevels()                                     const noexcept;
+                                                       void   decode(const char*, const std::size_t, Symbols_t&) const;
+                                                std::size_t   emit(const std::size_t, const char*, const std::size_t, const Symbols_t&, char*) const noexcept;
+    };
+
+///==============================================================================
+/// @brief Makes the tables of several levels in a direction.
+/// @tparam D Direction of the transformation.
+/// @param levels Levels to perform the transformation. They are positive.
+/// @param isa Instruction set of the ASCII kernel, when the alphabets use it.
+/// @return The tables.
+///==============================================================================
+template <Language_t L>
+template <Direction_t D>
+MultiLevelTable_t<L>
+MultiLevelTable_t<L>::make(const std::vector<int>& levels, const Isa_t isa){
+
+    std::vector<int> shifts { };
+
+    shifts.reserve(levels.size());
+
+    for (const int currentLevel : levels)
+       shifts.push_back(Properties_t::template getShift<D>(currentLevel));
+
+    return MultiLevelTable_t { std::move(shifts), isa };
+}
+
+///==============================================================================
+/// @brief Constructor of the MultiLevelTable_t class.
+/// @param shifts Positions that every letter moves forward at each level.
+/// @param isa Instruction set of the ASCII kernel, when the alphabets use it.
+///==============================================================================
+template <Language_t L>
+MultiLevelTable_t<L>::MultiLevelTable_t(std::vector<int>&& shifts, const Isa_t isa)
+    : m_shifts { std::move(shifts) } {
+
+    if constexpr (Properties_t::IS_ASCII_ROTATION){
+       m_asciiKernel= getAsciiKernel(selectIsa(isa));
+    }
+    else{
+       m_tables.resize(m_shifts.size());
+
+       for (std::size_t level= 0; level < m_shifts.size(); level++){
+          Table_t& table { m_tables[level] };
+
+          //Every ASCII character is copied as it is unless it is a letter.
+          for (std::size_t i= 0; i < 0x80; i++){
+             table[i].bytes[0]= static_cast<char>(i);
+             table[i].length  = 1;
+          }
+
+          loadAlphabet(table, Traits_t::uppercase, m_shifts[level]);
+          loadAlphabet(table, Traits_t::lowercase, m_shifts[level]);
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Stores the transformed character of every letter of an alphabet.
+/// @param table Table of the level.
+/// @param codePoints Code points of the alphabet.
+/// @param shift Positions that every letter moves forward.
+///==============================================================================
+template <Language_t L>
+void
+MultiLevelTable_t<L>::loadAlphabet(Table_t& table, const std::array<char32_t, Properties_t::NUM_LETTERS>& codePoints, const int shift) noexcept{
+
+    for (int position= 0; position < Properties_t::NUM_LETTERS; position++){
+       Entry_t& entry { table[SYMBOL_OF_CODE_POINT[codePoints[position]]] };
+
+       entry.length= encodeUTF8(codePoints[(position + shift) % Properties_t::NUM_LETTERS], entry.bytes);
+    }
+}
+
+///==============================================================================
+/// @brief Gets the size of the buffer needed to transform a block at a level.
+/// @param length Size of the block in bytes.
+/// @return The number of bytes that the output buffer must have.
+///==============================================================================
+template <Language_t L>
+constexpr std::size_t
+MultiLevelTable_t<L>::getMaxOutputLength(const std::size_t length) noexcept{
+
+    return length * Properties_t::EXPANSION + UTF8_MAX_LENGTH;
+}
+
+///==============================================================================
+/// @brief Gets the number of levels.
+/// @return The number of levels.
+///==============================================================================
+template <Language_t L>
+std::size_t
+MultiLevelTable_t<L>::getNumLevels() const noexcept{
+
+    return m_shifts.size();
+}
+
+///==============================================================================
+/// @brief Decodes a block once for all the levels.
+/// @param input Block to decode. It must not end in the middle of a character.
+/// @param length Size of the block in bytes.
+/// @param decoded Where the symbols will be stored.
+///==============================================================================
+template <Language_t L>
+void
+MultiLevelTable_t<L>::decode(const char* input, const std::size_t length, Symbols_t& decoded) const{
+
+    if constexpr (!Properties_t::IS_ASCII_ROTATION){
+       std::size_t in { 0 };
+
+       if (decoded.symbols.size() < length){
+          decoded.symbols.resize(length);
+          decoded.lengths.resize(length);
+       }
+
+       decoded.count= 0;
+
+       while (in < length){
+          const unsigned char byte       { static_cast<unsigned char>(input[in]) };
+                std::uint8_t  symbol     { RAW_SYMBOL };
+                int           charLength { 1 };
+
+          if (byte < 0x80){
+             symbol= byte;
+          }
+          else{
+             const int  utf8Size  { utf8Length(byte) };
+                   long codePoint { -1 };
+
+             if (utf8Size > 0 && in + utf8Size <= length)
+                codePoint= decodeUTF8(input + in, utf8Size);
+
+             //Invalid or truncated UTF-8 characters are copied byte by byte.
+             if (codePoint >= 0){
+                charLength= utf8Size;
+
+                if (static_cast<std::size_t>(codePoint) < SYMBOL_OF_CODE_POINT.size() && SYMBOL_OF_CODE_POINT[codePoint] != RAW_SYMBOL){
+                   char canonical[UTF8_MAX_LENGTH] { };
+
+                   if (encodeUTF8(static_cast<char32_t>(codePoint), canonical) == utf8Size)
+                      symbol= SYMBOL_OF_CODE_POINT[codePoint];
+                }
+             }
+          }
+
+          decoded.symbols[decoded.count]= symbol;
+          decoded.lengths[decoded.count]= static_cast<std::uint8_t>(charLength);
+          decoded.count++;
+          in+= charLength;
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Writes a decoded block transformed at one of the levels.
+/// @param levelIndex Position of the level in the list of levels.
+/// @param input Block that was decoded.
+/// @param length Size of the block in bytes.
+/// @param decoded Symbols of the block.
+/// @param output Where the transformed block will be stored. It must have at
+///        least getMaxOutputLength(length) bytes.
+/// @return The number of bytes written in the output.
+///==============================================================================
+template <Language_t L>
+std::size_t
+MultiLevelTable_t<L>::emit(const std::size_t levelIndex, const char* input, const std::size_t length, const Symbols_t& decoded, char* output) const noexcept{
+
+    if constexpr (Properties_t::IS_ASCII_ROTATION){
+       m_asciiKernel(input, length, output, m_shifts[levelIndex]);
+
+       return length;
+    }
+    else{
+       const Entry_t*      entries { m_tables[levelIndex].data() };
+       const std::uint8_t* symbols { decoded.symbols.data() };
+       const std::uint8_t* lengths { decoded.lengths.data() };
+             std::size_t   in      { 0 };
+             std::size_t   out     { 0 };
+
+       for (std::size_t i= 0; i < decoded.count; i++){
+          if (symbols[i] != RAW_SYMBOL){
+             std::memcpy(output + out, entries[symbols[i]].bytes, UTF8_MAX_LENGTH);
+             out+= entries[symbols[i]].length;
+          }
+          else{
+             std::memcpy(output + out, input + in, lengths[i]);
+             out+= lengths[i];
+          }
+
+          in+= lengths[i];
+       }
+
+       return out;
+    }
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <future>
+#include <vector>
+#include "../trace/probes.hpp"
+#include "../trace/traceRecorder.hpp"
+#include "transformer.hpp"
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the Transformer_t class.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param currentLevel Level to perform the transformation. It is positive.
+/// @param isa Instruction set of the ASCII kernel.
+/// @param threads Number of threads. If it is 0, one per hardware thread.
+///==============================================================================
+Transformer_t::Transformer_t(const Language_t language, const Direction_t direction, const int currentLevel, const Isa_t isa, const std::size_t threads) noexcept
+    : m_table { makeTable(language, direction, currentLevel, isa) }, m_level { currentLevel }, m_threads { threads > 0 ? threads : getDefaultThreads() } {
+
+}
+
+///==============================================================================
+/// @brief Makes the specialization of the translation table.
+/// @param language Language of the alphabets.
+/// @param direction Direction of the transformation.
+/// @param currentLevel Level to perform the transformation.
+/// @param isa Instruction set of the ASCII kernel.
+/// @return The translation table.
+///==============================================================================
+Transformer_t::Table_t
+Transformer_t::makeTable(const Language_t language, const Direction_t direction, const int currentLevel, const Isa_t isa) noexcept{
+
+    switch (language){
+       case spanishLanguage:
+          if (direction == encryptDirection)
+             return TranslationTable_t<spanishLanguage>::make<encryptDirection>(currentLevel, isa);
+          else
+             return TranslationTable_t<spanishLanguage>::make<decryptDirection>(currentLevel, isa);
+       default:
+          if (direction == encryptDirection)
+             return TranslationTable_t<englishLanguage>::make<encryptDirection>(currentLevel, isa);
+          else
+             return TranslationTable_t<englishLanguage>::make<decryptDirection>(currentLevel, isa);
+    }
+}
+
+///==============================================================================
+/// @brief Gets the size of the buffer needed to transform a text.
+/// @param length Size of the text to transform in bytes.
+/// @return The number of bytes that the output buffer must have.
+///==============================================================================
+std::size_t
+Transformer_t::getMaxOutputLength(const std::size_t length) const noexcept{
+
+    return std::visit([length](const auto& table){ return table.getMaxOutputLength(length); }, m_table);
+}
+
+///==============================================================================
+/// @brief Transforms a text.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored. It must have at
+///        least getMaxOutputLength(length) bytes.
+/// @return The number of bytes written in the output.
+///==============================================================================
+std::size_t
+Transformer_t::transform(const char* input, const std::size_t length, char* output) const noexcept{
+
+    const std::size_t written { std::visit([=](const auto& table){ return table.transform(input, length, output); }, m_table) };
+
+    CAESAR_PROBE3(block_transform, m_level, length, written);
+
+    return written;
+}
+
+///==============================================================================
+/// @brief Transforms a text and writes it. The text is transformed in windows
+///        of one chunk of MIN_CHUNK_SIZE per thread, split at character
+///        boundaries so a multi-byte letter is never cut in half, and every
+///        window is written before the next one starts: the memory used and
+///        the wait for the first byte don't depend on the size of the text.
+///        The calling thread takes the first chunk of every window and writes
+///        it as soon as it is ready; the rest are written in order.
+/// @param input Text to transform.
+/// @param write Receives the transformed text piece by piece, in order.
+///==============================================================================
+void
+Transformer_t::run(const std::string_view input, const std::function<void(const char*, const std::size_t)>& write) const{
+
+    const std::size_t                    numThreads { getChunkBounds(input).size() - 1 };
+    const std::size_t                    windowSize { numThreads * MIN_CHUNK_SIZE };
+          //The output of every chunk of a window, reused by the next window.
+          std::vector<std::vector<char>> outputs    ( numThreads );
+          std::vector<std::size_t>       sizes      ( numThreads );
+          std::size_t                    firstChunk { 0 };
+          //It is destroyed first, so no thread is left using the outputs if something fails.
+          WorkerPool_t                   pool       { numThreads - 1 };
+
+    auto transformChunk { [this, &outputs, &sizes](const std::size_t chunk, const std::size_t traceChunk, const std::string_view piece){
+       TraceSpan_t        span   { "transform", "chunk" };
+       std::vector<char>& output { outputs[chunk] };
+
+       span.setArgument("chunk", static_cast<long long>(traceChunk));
+       span.setArgument("bytes", static_cast<long long>(piece.length()));
+
+       if (output.size() < getMaxOutputLength(piece.length()))
+          output.resize(getMaxOutputLength(piece.length()));
+
+       sizes[chunk]= transform(piece.data(), piece.length(), output.data());
+    } };
+
+    for (std::size_t start= 0; start < input.length(); ){
+       std::size_t end { start + windowSize < input.length() ? findUTF8Boundary(input.data(), input.length(), start + windowSize) : input.length() };
+
+       if (end <= start)
+          end= std::min(start + windowSize, input.length());
+
+       const std::string_view               window    { input.substr(start, end - start) };
+       const std::vector<std::size_t>       bounds    { getChunkBounds(window) };
+       const std::size_t                    numChunks { bounds.size() - 1 };
+             std::vector<std::future<void>> tasks     { };
+
+       for (std::size_t chunk= 1; chunk < numChunks; chunk++)
+          tasks.push_back(pool.submit([transformChunk, chunk, traceChunk= firstChunk + chunk, piece= window.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk])](){
+             transformChunk(chunk, traceChunk, piece);
+          }));
+
+       transformChunk(0, firstChunk, window.substr(0, bounds[1]));
+
+       for (std::size_t chunk= 0; chunk < numChunks; chunk++){
+          if (chunk > 0){
+             TraceSpan_t span { "wait", "chunk" };
+
+             span.setArgument("chunk", static_cast<long long>(firstChunk + chunk));
+             tasks[chunk - 1].get();
+          }
+
+          TraceSpan_t span { "write", "chunk" };
+
+          span.setArgument("chunk", static_cast<long long>(firstChunk + chunk));
+          span.setArgument("bytes", static_cast<long long>(sizes[chunk]));
+          write(outputs[chunk].data(), sizes[chunk]);
+       }
+
+       firstChunk+= numChunks;
+       start= end;
+    }
+}
+
+///==============================================================================
+/// @brief Transforms a text straight into its place in the output, with the
+///        chunks shared out between the threads like run(). Only valid when
+///        isLengthPreserving(); the output can be the input itself.
+/// @param input Text to transform.
+/// @param output Where the transformed text will be stored. It must have the
+///        size of the input.
+///==============================================================================
+void
+Transformer_t::runInto(const std::string_view input, char* output) const{
+
+    const std::vector<std::size_t>       bounds    { getChunkBounds(input) };
+    const std::size_t                    numChunks { bounds.size() - 1 };
+          std::vector<std::future<void>> tasks     { };
+          WorkerPool_t                   pool      { numChunks - 1 };
+
+    auto transformChunk { [this, &input, output](const std::size_t chunk, const std::size_t first, const std::size_t last){
+       TraceSpan_t span { "transform", "chunk" };
+
+       span.setArgument("chunk", static_cast<long long>(chunk));
+       span.setArgument("bytes", static_cast<long long>(last - first));
+       transform(input.data() + first, last - first, output + first);
+    } };
+
+    for (std::size_t chunk= 1; chunk < numChunks; chunk++)
+       tasks.push_back(pool.submit([transformChunk, chunk, first= bounds[chunk], last= bounds[chunk + 1]](){ transformChunk(chunk, first, last); }));
+
+    transformChunk(0, bounds[0], bounds[1]);
+
+    for (std::future<void>& task : tasks)
+       task.get();
+}
+
+///==============================================================================
+/// @brief Indicates whether the output always has the size of the input.
+/// @return true whether the alphabets are A-Z and a-z.
+///==============================================================================
+bool
+Transformer_t::isLengthPreserving() const noexcept{
+
+    return std::visit([](const auto& table){ return table.isLengthPreserving(); }, m_table);
+}
+
+///==============================================================================
+/// @brief Splits a text in chunks for the threads. A text of at least two
+///        chunks of MIN_CHUNK_SIZE gets one chunk per thread, split at character
+///        boundaries so a multi-byte letter is never cut in half.
+/// @param input Text to split.
+/// @return The positions where the chunks start, followed by the size of the
+///         text.
+///==============================================================================
+std::vector<std::size_t>
+Transformer_t::getChunkBounds(const std::string_view input) const{
+
+    const std::size_t              numChunks { std::max<std::size_t>(1, std::min(m_threads, input.length() / MIN_CHUNK_SIZE)) };
+          std::vector<std::size_t> bounds    { 0 };
+
+    for (std::size_t chunk= 1; chunk < numChunks; chunk++)
+       bounds.push_back(std::max(bounds.back(), findUTF8Boundary(input.data(), input.length(), chunk * input.length() / numChunks)));
+
+    bounds.push_back(input.length());
+
+    return bounds;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <variant>
+#include "translationTable.hpp"
+
+namespace SherpadCaesar{
+
+/// @class Transformer_t
+/// @brief Transforms texts at a level of a language in a direction. The specialization of the translation table is
+///        chosen once, when the transformer is built, instead of once per character. A big text can be split at
+///        character boundaries in chunks that are transformed by several threads and written in order.
+
+    class Transformer_t{
+        private:
+            using Table_t= std::variant<TranslationTable_t<englishLanguage>, TranslationTable_t<spanishLanguage>>;
+
+                                                              /// @brief Translation table of the language, level and direction.
+                                                    Table_t   m_table;
+
+                                                              /// @brief Level of the table, passed to the block_transform probe.
+                                                        int   m_level;
+
+                                                              /// @brief Number of threads that share out the chunks of a text.
+                                                std::size_t   m_threads;
+
+            static                                  Table_t   makeTable(const Language_t, const Direction_t, const int, const Isa_t)        noexcept;
+                                   std::vector<std::size_t>   getChunkBounds(const std::string_view)        const;
+
+        public:
+                                                              Transformer_t(const Language_t, const Direction_t, const int, const Isa_t= automaticIsa, const std::size_t= 1) noexcept;
+                                                              Transformer_t(const Transformer_t&)                 = default;
+                                                              Transformer_t(      Transformer_t&&)                = default;
+                                                             ~Transformer_t()                                     = default;
+                                             Transformer_t&   operator=(const Transformer_t&)                     = default;
+                                             Transformer_t&   operator=(      Transformer_t&&)                    = default;
+                                                std::size_t   getMaxOutputLength(const std::size_t)         const noexcept;
+                                                std::size_t   transform(const char*, const std::size_t, char*) const noexcept;
+                                                       bool   isLengthPreserving()                          const noexcept;
+                                                       void   run(const std::string_view, const std::function<void(const char*, const std::size_t)>&) const;
+                                                       void   runInto(const std::string_view, char*)        const;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include "../dat/utils/utf8.hpp"
+#include "asciiKernel.hpp"
+#include "languageTraits.hpp"
+
+namespace SherpadCaesar{
+
+/// @class TranslationTable_t
+/// @brief Precomputes, for a language, a level and a direction, the transformed character of every letter of the
+///        alphabets indexed by code point, so the transformation doesn't search the alphabets or allocate per character.
+///        The language is a template parameter and the direction is resolved when the table is made, so the loop
+///        has no branch on either of them.
+/// @tparam L Language of the alphabets.
+
+template <Language_t L>
+    class TranslationTable_t{
+        private:
+            using Properties_t= AlphabetProperties_t<L>;
+            using Traits_t    = LanguageTraits_t<L>;
+
+            /// @brief Transformed character of a code point.
+            struct Entry_t{
+                                                              /// @brief UTF-8 bytes of the transformed character.
+                                                       char   bytes[UTF8_MAX_LENGTH]  { };
+
+                                                              /// @brief Number of bytes of the transformed character. 0 if the code point isn't a letter.
+                                              unsigned char   length                  { 0 };
+
+                                                              /// @brief Number of bytes of the original character.
+                                              unsigned char   sourceLength            { 0 };
+            };
+
+                                                              /// @brief Number of entries of the table. Every ASCII character has an entry.
+            static constexpr                    std::size_t   NUM_ENTRIES             { Properties_t::MAX_CODE_POINT < 0x80 ? 0x80 : Properties_t::MAX_CODE_POINT + 1 };
+
+                                                              /// @brief Transformed characters indexed by code point.
+                             std::array<Entry_t, NUM_ENTRIES> m_entries               { };
+
+                                                              /// @brief Vectorized kernel used instead of the table when the alphabets are A-Z and a-z.
+                                              AsciiKernel_t   m_asciiKernel           { nullptr };
+
+                                                              /// @brief Positions that every letter moves forward.
+                                                        int   m_shift                 { 0 };
+
+                                                              TranslationTable_t(const int, const Isa_t)                   noexcept;
+                                                       void   loadAlphabet(const std::array<char32_t, Properties_t::NUM_LETTERS>&) noexcept;
+
+        public:
+                                                              TranslationTable_t(const TranslationTable_t&)            = default;
+                                                              TranslationTable_t(      TranslationTable_t&&)           = default;
+                                                             ~TranslationTable_t()                                     = default;
+                                        TranslationTable_t&   operator=(const TranslationTable_t&)                     = default;
+                                        TranslationTable_t&   operator=(      TranslationTable_t&&)                    = default;
+                      template <Direction_t D>
+                      static            TranslationTable_t    make(const int, const Isa_t= automaticIsa)                   noexcept;
+                      static constexpr          std::size_t   getMaxOutputLength(const std::size_t)                        noexcept;
+                      static constexpr                 bool   isLengthPreserving()                                         noexcept;
+                                                std::size_t   transform(const char*, const std::size_t, char*)       const noexcept;
+    };
+
+///==============================================================================
+/// @brief Makes the table of a level and a direction.
+/// @tparam D Direction of the transformation.
+/// @param currentLevel Level to perform the transformation. It is positive.
+/// @param isa Instruction set of the ASCII kernel, when the alphabets use it.
+/// @return The table.
+///==============================================================================
+template <Language_t L>
+template <Direction_t D>
+TranslationTable_t<L>
+TranslationTable_t<L>::make(const int currentLevel, const Isa_t isa) noexcept{
+
+    return TranslationTable_t { Properties_t::template getShift<D>(currentLevel), isa };
+}
+
+///==============================================================================
+/// @brief Constructor of the TranslationTable_t class.
+/// @param shift Positions that every letter moves forward (0 to letters - 1).
+/// @param isa Instruction set of the ASCII kernel, when the alphabets use it.
+///==============================================================================
+template <Language_t L>
+TranslationTable_t<L>::TranslationTable_t(const int shift, const Isa_t isa) noexcept
+    : m_shift { shift } {
+
+    if constexpr (Properties_t::IS_ASCII_ROTATION){
+       m_asciiKernel= getAsciiKernel(selectIsa(isa));
+    }
+    else{
+       //Every ASCII character is copied as it is unless it is a letter.
+       for (std::size_t i= 0; i < 0x80; i++){
+          m_entries[i].bytes[0]    = static_cast<char>(i);
+          m_entries[i].length      = 1;
+          m_entries[i].sourceLength= 1;
+       }
+
+       loadAlphabet(Traits_t::uppercase);
+       loadAlphabet(Traits_t::lowercase);
+    }
+}
+
+///==============================================================================
+/// @brief Stores the transformed character of every letter of an alphabet.
+/// @param codePoints Code points of the alphabet.
+///==============================================================================
+template <Language_t L>
+void
+TranslationTable_t<L>::loadAlphabet(const std::array<char32_t, Properties_t::NUM_LETTERS>& codePoints) noexcept{
+
+    for (int position= 0; position < Properties_t::NUM_LETTERS; position++){
+       Entry_t& entry                   { m_entries[codePoints[position]] };
+       char     source[UTF8_MAX_LENGTH] { };
+
+       entry.length      = encodeUTF8(codePoints[(position + m_shift) % Properties_t::NUM_LETTERS], entry.bytes);
+       entry.sourceLength= encodeUTF8(codePoints[position], source);
+    }
+}
+
+///==============================================================================
+/// @brief Gets the size of the buffer needed to transform a text.
+/// @param length Size of the text to transform in bytes.
+/// @return The number of bytes that the output buffer must have.
+///==============================================================================
+template <Language_t L>
+constexpr std::size_t
+TranslationTable_t<L>::getMaxOutputLength(const std::size_t length) noexcept{
+
+    //The extra bytes let the loop copy whole entries without checking their size.
+    return length * Properties_t::EXPANSION + UTF8_MAX_LENGTH;
+}
+
+///==============================================================================
+/// @brief Indicates whether the output always has the size of the input, so it
+///        can be written at the same offsets, even over the input itself.
+/// @return true whether the alphabets are A-Z and a-z.
+///==============================================================================
+template <Language_t L>
+constexpr bool
+TranslationTable_t<L>::isLengthPreserving() noexcept{
+
+    return Properties_t::IS_ASCII_ROTATION;
+}
+
+///==============================================================================
+/// @brief Transforms a text. Characters that aren't letters of the alphabets,
+///        including invalid UTF-8 bytes, are copied as they are.
+/// @param input Text to transform.
+/// @param length Size of the text in bytes.
+/// @param output Where the transformed text will be stored. It must have at
+///        least getMaxOutputLength(length) bytes.
+/// @return The number of bytes written in the output.
+///==============================================================================
+template <Language_t L>
+std::size_t
+TranslationTable_t<L>::transform(const char* input, const std::size_t length, char* output) const noexcept{
+
+    if constexpr (Properties_t::IS_ASCII_ROTATION){
+       m_asciiKernel(input, length, output, m_shift);
+
+       return length;
+    }
+    else{
+       const Entry_t* entries { m_entries.data() };
+       std::size_t    in      { 0 };
+       std::size_t    out     { 0 };
+
+       while (in < length){
+          const unsigned char byte { static_cast<unsigned char>(input[in]) };
+
+          if (byte < 0x80){
+             std::memcpy(output + out, entries[byte].bytes, UTF8_MAX_LENGTH);
+             out+= entries[byte].length;
+             in++;
+          }
+          else{
+             int  charLength { utf8Length(byte) };
+             long codePoint  { -1 };
+
+             if (charLength > 0 && in + charLength <= length)
+                codePoint= decodeUTF8(input + in, charLength);
+
+             if (codePoint < 0){
+                //Invalid or truncated UTF-8 character: the byte is copied alone.
+                charLength= 1;
+                output[out]= input[in];
+                out++;
+             }
+             else if (static_cast<std::size_t>(codePoint) < NUM_ENTRIES && entries[codePoint].sourceLength == charLength){
+                std::memcpy(output + out, entries[codePoint].bytes, UTF8_MAX_LENGTH);
+                out+= entries[codePoint].length;
+             }
+             else{
+                std::memcpy(output + out, input + in, charLength);
+                out+= charLength;
+             }
+
+             in+= charLength;
+          }
+       }
+
+       return out;
+    }
+}
+
+} // namespace SherpadCaesar
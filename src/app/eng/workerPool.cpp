@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <memory>
+#include "workerPool.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the WorkerPool_t class. Starts the threads.
+/// @param numWorkers Number of threads. It can be 0, then nothing runs in
+///        parallel and the tasks must not be submitted.
+///==============================================================================
+WorkerPool_t::WorkerPool_t(const std::size_t numWorkers){
+
+    m_workers.reserve(numWorkers);
+
+    for (std::size_t i= 0; i < numWorkers; i++)
+       m_workers.emplace_back([this](){ work(); });
+}
+
+///==============================================================================
+/// @brief Destructor of the WorkerPool_t class. The threads finish the pending
+///        tasks before they are joined.
+///==============================================================================
+WorkerPool_t::~WorkerPool_t(){
+
+    {
+       std::lock_guard<std::mutex> lock { m_mutex };
+
+       m_stop= true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread& worker : m_workers)
+       worker.join();
+}
+
+///==============================================================================
+/// @brief Adds a task to the queue.
+/// @param task Task to run.
+/// @return The future that indicates when the task has finished.
+///==============================================================================
+std::future<void>
+WorkerPool_t::submit(std::function<void()> task){
+
+    //std::function needs a copyable target, so the packaged task is shared.
+    auto              packagedTask { std::make_shared<std::packaged_task<void()>>(std::move(task)) };
+    std::future<void> result       { packagedTask->get_future() };
+
+    {
+       std::lock_guard<std::mutex> lock { m_mutex };
+
+       m_tasks.emplace([packagedTask](){ (*packagedTask)(); });
+    }
+
+    m_condition.notify_one();
+
+    return result;
+}
+
+///==============================================================================
+/// @brief Gets the number of threads.
+/// @return The number of threads of the pool.
+///==============================================================================
+std::size_t
+WorkerPool_t::getNumWorkers() const noexcept{
+
+    return m_workers.size();
+}
+
+///==============================================================================
+/// @brief Loop of every thread: takes the tasks of the queue until the pool
+///        stops.
+///==============================================================================
+void
+WorkerPool_t::work(){
+
+    while (true){
+       std::function<void()> task { };
+
+       {
+          std::unique_lock<std::mutex> lock { m_mutex };
+
+          m_condition.wait(lock, [this](){ return m_stop || !m_tasks.empty(); });
+
+          if (m_tasks.empty())
+             return;
+
+          task= std::move(m_tasks.front());
+          m_tasks.pop();
+       }
+
+       task();
+    }
+}
+
+///==============================================================================
+/// @brief Gets the number of threads used when the user doesn't choose it.
+/// @return The number of hardware threads, or 1 if it is unknown.
+///==============================================================================
+std::size_t
+getDefaultThreads() noexcept{
+
+    const unsigned int hardwareThreads { std::thread::hardware_concurrency() };
+
+    return hardwareThreads > 0 ? hardwareThreads : 1;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @class WorkerPool_t
+/// @brief Runs tasks in a fixed number of threads. Every task returns a future, so the caller can wait for the results
+///        in the order it needs regardless of the order in which they finish. The exceptions of a task are thrown again
+///        when its future is read.
+
+    class WorkerPool_t{
+        private:
+                                                              /// @brief Threads that run the tasks.
+                                   std::vector<std::thread>   m_workers           { };
+
+                                                              /// @brief Tasks waiting for a free thread.
+                          std::queue<std::function<void()>>   m_tasks             { };
+
+                                                              /// @brief Protects the tasks and the stop flag.
+                                                 std::mutex   m_mutex             { };
+
+                                                              /// @brief Wakes up the threads when there is a task or they have to stop.
+                                    std::condition_variable   m_condition         { };
+
+                                                              /// @brief Indicates whether the threads have to finish when there are no tasks.
+                                                       bool   m_stop              { false };
+
+                                                       void   work();
+
+        public:
+                explicit                                      WorkerPool_t(const std::size_t);
+                                                              WorkerPool_t(const WorkerPool_t&)                = delete;
+                                                              WorkerPool_t(      WorkerPool_t&&)               = delete;
+                                                             ~WorkerPool_t();
+                                              WorkerPool_t&   operator=(const WorkerPool_t&)                   = delete;
+                                              WorkerPool_t&   operator=(      WorkerPool_t&&)                  = delete;
+                                          std::future<void>   submit(std::function<void()>);
+                                                std::size_t   getNumWorkers()                            const noexcept;
+    };
+
+      std::size_t      getDefaultThreads()                               noexcept;
+
+} // namespace SherpadCaesar
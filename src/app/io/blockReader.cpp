@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "blockReader.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the BlockReader_t class. Opens the file.
+/// @param fileName Path where the file is located, or "-" for the standard
+///        input.
+/// @param blockSize Biggest size of a block in bytes. It must be able to hold
+///        several UTF-8 characters.
+///==============================================================================
+BlockReader_t::BlockReader_t(const std::string_view fileName, const std::size_t blockSize)
+    : m_buffer ( blockSize ) {
+
+    if (fileName == STANDARD_INPUT_PATH)
+       m_fileDescriptor= STDIN_FILENO;
+    else{
+       //The view doesn't have to end in '\0'.
+       m_fileDescriptor= ::open(std::string { fileName }.c_str(), O_RDONLY | O_CLOEXEC);
+       m_ownsDescriptor= true;
+    }
+
+    if (m_fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_3);
+}
+
+///==============================================================================
+/// @brief Destructor of the BlockReader_t class. Closes the file, but not the
+///        standard input.
+///==============================================================================
+BlockReader_t::~BlockReader_t(){
+
+    if (m_ownsDescriptor)
+       ::close(m_fileDescriptor);
+}
+
+///==============================================================================
+/// @brief Reads the next block of the file.
+/// @param block Where the block will be referenced. It is valid until the next
+///        call.
+/// @return true whether a block was read, false at the end of the file.
+///==============================================================================
+bool
+BlockReader_t::next(std::string_view& block){
+
+    std::size_t size { m_carrySize };
+
+    std::memmove(m_buffer.data(), m_buffer.data() + m_carryStart, m_carrySize);
+
+    //One read is enough: a pipe gives what it has ready and a regular file gives the whole block.
+    while (!m_endOfFile){
+       const ssize_t nRead { ::read(m_fileDescriptor, m_buffer.data() + size, m_buffer.size() - size) };
+
+       if (nRead < 0){
+          if (errno == EINTR)
+             continue;
+
+          throw CaesarException_t(EXCEPTION_7);
+       }
+
+       m_endOfFile= nRead == 0;
+       size+= static_cast<std::size_t>(nRead);
+       break;
+    }
+
+    //At the end of the file a cut character can't be completed, so it is kept as it is.
+    const std::size_t blockSize { m_endOfFile ? size : getCompleteUTF8Length(m_buffer.data(), size) };
+
+    m_carryStart= blockSize;
+    m_carrySize = size - blockSize;
+    block       = std::string_view { m_buffer.data(), blockSize };
+
+    return size > 0;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @class BlockReader_t
+/// @brief Reads a file in blocks of a fixed size that never end in the middle of a UTF-8 character. The bytes of a
+///        character cut at the end of a block are carried over to the start of the next one, so the memory used
+///        depends on the size of the block and not on the size of the file. It can read the standard input, where a
+///        block is what a pipe has ready, so the output of a pipeline isn't held back until a whole block arrives.
+
+    class BlockReader_t{
+        private:
+                                                              /// @brief Descriptor of the file to read.
+                                                        int   m_fileDescriptor    { -1 };
+
+                                                              /// @brief Indicates whether the reader opened the descriptor and has to close it.
+                                                       bool   m_ownsDescriptor    { false };
+
+                                                              /// @brief Indicates whether the end of the file was reached.
+                                                       bool   m_endOfFile         { false };
+
+                                                              /// @brief Block read. It has the bytes carried over followed by the new ones.
+                                          std::vector<char>   m_buffer            { };
+
+                                                              /// @brief Position in the buffer of the bytes carried over to the next block.
+                                                std::size_t   m_carryStart        { 0 };
+
+                                                              /// @brief Number of bytes carried over to the next block.
+                                                std::size_t   m_carrySize         { 0 };
+
+        public:
+                                                              BlockReader_t(const std::string_view, const std::size_t);
+                                                              BlockReader_t(const BlockReader_t&)              = delete;
+                                                              BlockReader_t(      BlockReader_t&&)             = delete;
+                                                             ~BlockReader_t();
+                                             BlockReader_t&   operator=(const BlockReader_t&)                  = delete;
+                                             BlockReader_t&   operator=(      BlockReader_t&&)                 = delete;
+                                                       bool   next(std::string_view&);
+    };
+
+} // namespace SherpadCaesar
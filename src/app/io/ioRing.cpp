@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "ioRing.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && !defined(CAESAR_NO_IO_URING)
+   #include <linux/io_uring.h>
+   #define CAESAR_IO_URING 1
+#endif
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the IoRing_t class. Creates the ring and maps its
+///        queues. If it fails, the ring isn't available.
+/// @param numEntries Biggest number of operations queued at the same time.
+///==============================================================================
+IoRing_t::IoRing_t([[maybe_unused]] const unsigned numEntries){
+
+#ifdef CAESAR_IO_URING
+    io_uring_params params { };
+
+    m_fileDescriptor= static_cast<int>(::syscall(__NR_io_uring_setup, numEntries, &params));
+
+    if (m_fileDescriptor < 0)
+       return;
+
+    //IORING_OP_READ and IORING_OP_WRITE came with this feature (Linux 5.6).
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0){
+       release();
+       return;
+    }
+
+    m_numEntries = params.sq_entries;
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    m_entriesSize= params.sq_entries * sizeof(io_uring_sqe);
+
+    //Newer kernels share one mapping for both queues.
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+       m_sqRingSize= m_cqRingSize= std::max(m_sqRingSize, m_cqRingSize);
+
+    m_sqRing= ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fileDescriptor, IORING_OFF_SQ_RING);
+
+    if (m_sqRing == MAP_FAILED){
+       m_sqRing= nullptr;
+       release();
+       return;
+    }
+
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+       m_cqRing= m_sqRing;
+    else{
+       m_cqRing= ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fileDescriptor, IORING_OFF_CQ_RING);
+
+       if (m_cqRing == MAP_FAILED){
+          m_cqRing= nullptr;
+          release();
+          return;
+       }
+    }
+
+    m_entries= ::mmap(nullptr, m_entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fileDescriptor, IORING_OFF_SQES);
+
+    if (m_entries == MAP_FAILED){
+       m_entries= nullptr;
+       release();
+       return;
+    }
+
+    char* sqRing { static_cast<char*>(m_sqRing) };
+    char* cqRing { static_cast<char*>(m_cqRing) };
+
+    m_sqHead = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+    m_sqMask = reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+    m_sqArray= reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+    m_cqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+    m_cqMask = reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+    m_cqes   = cqRing + params.cq_off.cqes;
+#endif
+}
+
+///==============================================================================
+/// @brief Queues an operation. It is given to the kernel by submitAndWait().
+/// @param opcode Operation.
+/// @param fileDescriptor File of the operation.
+/// @param buffer Memory read or written.
+/// @param length Size of the buffer in bytes.
+/// @param offset Position in the file.
+/// @param userData Value returned with the result.
+/// @return true whether there was room in the queue.
+///==============================================================================
+bool
+IoRing_t::prepare([[maybe_unused]] const int opcode, [[maybe_unused]] const int fileDescriptor, [[maybe_unused]] void* buffer, [[maybe_unused]] const std::size_t length,
+                  [[maybe_unused]] const std::uint64_t offset, [[maybe_unused]] const std::uint64_t userData) noexcept{
+
+#ifdef CAESAR_IO_URING
+    //Only this thread moves the tail; the kernel moves the head.
+    const unsigned tail { *m_sqTail };
+    const unsigned head { __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE) };
+
+    if (tail - head >= m_numEntries)
+       return false;
+
+    const unsigned      index { tail & *m_sqMask };
+          io_uring_sqe& entry { static_cast<io_uring_sqe*>(m_entries)[index] };
+
+    std::memset(&entry, 0, sizeof(entry));
+
+    entry.opcode   = static_cast<std::uint8_t>(opcode);
+    entry.fd       = fileDescriptor;
+    entry.addr     = reinterpret_cast<std::uint64_t>(buffer);
+    //Bigger operations are cut by the kernel and continued by the caller.
+    entry.len      = static_cast<std::uint32_t>(std::min<std::size_t>(length, 1U << 30));
+    entry.off      = offset;
+    entry.user_data= userData;
+
+    m_sqArray[index]= index;
+
+    __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+    m_toSubmit++;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+///==============================================================================
+/// @brief Gives the queued operations to the kernel and waits for results.
+/// @param minComplete Number of results to wait for. It can be 0.
+///==============================================================================
+void
+IoRing_t::submitAndWait([[maybe_unused]] const unsigned minComplete){
+
+#ifdef CAESAR_IO_URING
+    while (true){
+       const long submitted { ::syscall(__NR_io_uring_enter, m_fileDescriptor, m_toSubmit, minComplete, minComplete > 0 ? IORING_ENTER_GETEVENTS : 0, nullptr, 0) };
+
+       if (submitted >= 0){
+          m_toSubmit-= static_cast<unsigned>(submitted);
+          return;
+       }
+
+       if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+          throw CaesarException_t(EXCEPTION_14);
+    }
+#else
+    throw CaesarException_t(EXCEPTION_14);
+#endif
+}
+
+///==============================================================================
+/// @brief Takes the next result of an operation, if there is any.
+/// @param completion Where the result will be stored.
+/// @return true whether there was a result.
+///==============================================================================
+bool
+IoRing_t::nextCompletion([[maybe_unused]] IoCompletion_t& completion) noexcept{
+
+#ifdef CAESAR_IO_URING
+    const unsigned head { *m_cqHead };
+
+    if (head == __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE))
+       return false;
+
+    const io_uring_cqe& entry { static_cast<io_uring_cqe*>(m_cqes)[head & *m_cqMask] };
+
+    completion.userData= entry.user_data;
+    completion.result  = entry.res;
+
+    __atomic_store_n(m_cqHead, head + 1, __ATOMIC_RELEASE);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+///==============================================================================
+/// @brief Queues a read.
+/// @param fileDescriptor File to read.
+/// @param buffer Where the bytes will be stored.
+/// @param length Bytes to read.
+/// @param offset Position in the file.
+/// @param userData Value returned with the result.
+/// @return true whether there was room in the queue.
+///==============================================================================
+bool
+IoRing_t::prepareRead(const int fileDescriptor, char* buffer, const std::size_t length, const std::uint64_t offset, const std::uint64_t userData) noexcept{
+
+#ifdef CAESAR_IO_URING
+    return prepare(IORING_OP_READ, fileDescriptor, buffer, length, offset, userData);
+#else
+    return prepare(0, fileDescriptor, buffer, length, offset, userData);
+#endif
+}
+
+///==============================================================================
+/// @brief Queues a write.
+/// @param fileDescriptor File to write.
+/// @param buffer Bytes to write.
+/// @param length Number of bytes.
+/// @param offset Position in the file.
+/// @param userData Value returned with the result.
+/// @return true whether there was room in the queue.
+///==============================================================================
+bool
+IoRing_t::prepareWrite(const int fileDescriptor, const char* buffer, const std::size_t length, const std::uint64_t offset, const std::uint64_t userData) noexcept{
+
+#ifdef CAESAR_IO_URING
+    return prepare(IORING_OP_WRITE, fileDescriptor, const_cast<char*>(buffer), length, offset, userData);
+#else
+    return prepare(0, fileDescriptor, const_cast<char*>(buffer), length, offset, userData);
+#endif
+}
+
+
+///==============================================================================
+/// @brief Destructor of the IoRing_t class. Removes the mappings and closes the
+///        ring.
+///==============================================================================
+IoRing_t::~IoRing_t(){
+
+    release();
+}
+
+///==============================================================================
+/// @brief Removes the mappings and closes the ring, which isn't available
+///        afterwards.
+///==============================================================================
+void
+IoRing_t::release() noexcept{
+
+    if (m_entries != nullptr)
+       ::munmap(m_entries, m_entriesSize);
+    if (m_cqRing != nullptr && m_cqRing != m_sqRing)
+       ::munmap(m_cqRing, m_cqRingSize);
+    if (m_sqRing != nullptr)
+       ::munmap(m_sqRing, m_sqRingSize);
+    if (m_fileDescriptor >= 0)
+       ::close(m_fileDescriptor);
+
+    m_entries       = nullptr;
+    m_cqRing        = nullptr;
+    m_sqRing        = nullptr;
+    m_fileDescriptor= -1;
+}
+
+///==============================================================================
+/// @brief Indicates whether the kernel supports the ring.
+/// @return true whether operations can be queued.
+///==============================================================================
+bool
+IoRing_t::isAvailable() const noexcept{
+
+    return m_fileDescriptor >= 0;
+}
+
+} // namespace SherpadCaesar
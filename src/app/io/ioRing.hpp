@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SherpadCaesar{
+
+/// @brief Result of an operation of the ring.
+struct IoCompletion_t{
+                                                              /// @brief Value given when the operation was queued.
+                                              std::uint64_t   userData            { 0 };
+
+                                                              /// @brief Bytes read or written, or -errno if it failed.
+                                                        int   result              { 0 };
+};
+
+/// @class IoRing_t
+/// @brief Queues reads and writes to the kernel with io_uring(7), through its system calls and without liburing. The
+///        operations run while the caller does something else, and their results are collected later in any order.
+///        If the kernel or the build doesn't support it, isAvailable() is false and nothing can be queued.
+
+    class IoRing_t{
+        private:
+                                                              /// @brief Descriptor of the ring. -1 if it isn't available.
+                                                        int   m_fileDescriptor    { -1 };
+
+                                                              /// @brief Mapping of the submission queue.
+                                                       void*  m_sqRing            { nullptr };
+
+                                                              /// @brief Size of the mapping of the submission queue.
+                                                std::size_t   m_sqRingSize        { 0 };
+
+                                                              /// @brief Mapping of the completion queue. It can be the one of the submission queue.
+                                                       void*  m_cqRing            { nullptr };
+
+                                                              /// @brief Size of the mapping of the completion queue.
+                                                std::size_t   m_cqRingSize        { 0 };
+
+                                                              /// @brief Mapping of the submission entries.
+                                                       void*  m_entries           { nullptr };
+
+                                                              /// @brief Size of the mapping of the submission entries.
+                                                std::size_t   m_entriesSize       { 0 };
+
+                                                              /// @brief Fields of the submission queue shared with the kernel.
+                                                   unsigned*  m_sqTail            { nullptr };
+                                                   unsigned*  m_sqHead            { nullptr };
+                                                   unsigned*  m_sqMask            { nullptr };
+                                                   unsigned*  m_sqArray           { nullptr };
+
+                                                              /// @brief Fields of the completion queue shared with the kernel.
+                                                   unsigned*  m_cqHead            { nullptr };
+                                                   unsigned*  m_cqTail            { nullptr };
+                                                   unsigned*  m_cqMask            { nullptr };
+                                                       void*  m_cqes              { nullptr };
+
+                                                              /// @brief Number of submission entries.
+                                                   unsigned   m_numEntries        { 0 };
+
+                                                              /// @brief Operations queued but not given to the kernel yet.
+                                                   unsigned   m_toSubmit          { 0 };
+
+                                                       bool   prepare(const int, const int, void*, const std::size_t, const std::uint64_t, const std::uint64_t) noexcept;
+                                                       void   release()                                        noexcept;
+
+        public:
+                explicit                                      IoRing_t(const unsigned);
+                                                              IoRing_t(const IoRing_t&)                        = delete;
+                                                              IoRing_t(      IoRing_t&&)                       = delete;
+                                                             ~IoRing_t();
+                                                  IoRing_t&   operator=(const IoRing_t&)                       = delete;
+                                                  IoRing_t&   operator=(      IoRing_t&&)                      = delete;
+                                                       bool   isAvailable()                              const noexcept;
+                                                       bool   prepareRead(const int, char*, const std::size_t, const std::uint64_t, const std::uint64_t)       noexcept;
+                                                       bool   prepareWrite(const int, const char*, const std::size_t, const std::uint64_t, const std::uint64_t) noexcept;
+                                                       void   submitAndWait(const unsigned);
+                                                       bool   nextCompletion(IoCompletion_t&)                  noexcept;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "mappedFile.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the MappedFile_t class. Maps the file, or reads it if
+///        it can't be mapped.
+/// @param fileName Path where the file is located, or "-" for the standard
+///        input.
+///==============================================================================
+MappedFile_t::MappedFile_t(const std::string_view fileName){
+
+    const bool  isStandardInput { fileName == STANDARD_INPUT_PATH };
+    //The view doesn't have to end in '\0'.
+    const int   fileDescriptor  { isStandardInput ? STDIN_FILENO : ::open(std::string { fileName }.c_str(), O_RDONLY | O_CLOEXEC) };
+    struct stat status          { };
+
+    if (fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_3);
+
+    try{
+       //Some special files are regular but their size is 0 until they are read.
+       if (::fstat(fileDescriptor, &status) < 0 || !S_ISREG(status.st_mode) || status.st_size == 0 ||
+           !map(fileDescriptor, static_cast<std::size_t>(status.st_size)))
+          readAll(fileDescriptor);
+    }
+    catch (...){
+       if (!isStandardInput)
+          ::close(fileDescriptor);
+       throw;
+    }
+
+    //The mapping stays valid after the file is closed.
+    if (!isStandardInput)
+       ::close(fileDescriptor);
+}
+
+///==============================================================================
+/// @brief Destructor of the MappedFile_t class. Removes the mapping.
+///==============================================================================
+MappedFile_t::~MappedFile_t(){
+
+    if (m_mapping != nullptr)
+       ::munmap(m_mapping, m_mappingSize);
+}
+
+///==============================================================================
+/// @brief Maps a regular file in memory, read-only.
+/// @param fileDescriptor File to map.
+/// @param size Size of the file in bytes.
+/// @return true whether the file was mapped.
+///==============================================================================
+bool
+MappedFile_t::map(const int fileDescriptor, const std::size_t size) noexcept{
+
+    void* mapping { ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0) };
+
+    if (mapping == MAP_FAILED)
+       return false;
+
+    //The transformation reads it once from the start to the end: more read-ahead, and pages can be dropped sooner.
+    ::madvise(mapping, size, MADV_SEQUENTIAL);
+
+    m_mapping    = mapping;
+    m_mappingSize= size;
+
+    return true;
+}
+
+///==============================================================================
+/// @brief Reads a file until its end into the buffer.
+/// @param fileDescriptor File to read.
+///==============================================================================
+void
+MappedFile_t::readAll(const int fileDescriptor){
+
+    std::size_t size { 0 };
+
+    m_buffer.resize(DEFAULT_BUFFER_SIZE);
+
+    while (true){
+       const ssize_t nRead { ::read(fileDescriptor, m_buffer.data() + size, m_buffer.size() - size) };
+
+       if (nRead < 0){
+          if (errno == EINTR)
+             continue;
+
+          throw CaesarException_t(EXCEPTION_7);
+       }
+
+       if (nRead == 0)
+          break;
+
+       size+= static_cast<std::size_t>(nRead);
+
+       if (size == m_buffer.size())
+          m_buffer.resize(m_buffer.size() * 2);
+    }
+
+    m_buffer.resize(size);
+}
+
+///==============================================================================
+/// @brief Gets the content of the file.
+/// @return The content of the file. It is valid while the object exists.
+///==============================================================================
+std::string_view
+MappedFile_t::getContent() const noexcept{
+
+    if (m_mapping != nullptr)
+       return std::string_view { static_cast<const char*>(m_mapping), m_mappingSize };
+    else
+       return m_buffer;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace SherpadCaesar{
+
+/// @class MappedFile_t
+/// @brief Gives read-only access to the whole content of a file. A regular file is mapped in memory, so it is read
+///        straight from the page cache without copying it to the heap. Files that can't be mapped, such as pipes or
+///        special files whose size is unknown, are read with read() into a buffer.
+
+    class MappedFile_t{
+        private:
+                                                              /// @brief Start of the mapping. nullptr if the file was read into the buffer.
+                                                       void*  m_mapping           { nullptr };
+
+                                                              /// @brief Size of the mapping in bytes.
+                                                std::size_t   m_mappingSize       { 0 };
+
+                                                              /// @brief Content of the file when it couldn't be mapped.
+                                                std::string   m_buffer            { "" };
+
+                                                       bool   map(const int, const std::size_t)      noexcept;
+                                                       void   readAll(const int);
+
+        public:
+                explicit                                      MappedFile_t(const std::string_view);
+                                                              MappedFile_t(const MappedFile_t&)                = delete;
+                                                              MappedFile_t(      MappedFile_t&&)               = delete;
+                                                             ~MappedFile_t();
+                                              MappedFile_t&   operator=(const MappedFile_t&)                   = delete;
+                                              MappedFile_t&   operator=(      MappedFile_t&&)                  = delete;
+                                           std::string_view   getContent()                             const noexcept;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <charconv>
+#include <cstdio>
+#include <fstream>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "mirrorManifest.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the MirrorManifest_t class. The manifest starts empty.
+/// @param parameters Parameters of the transformation: language, direction and
+///        level.
+///==============================================================================
+MirrorManifest_t::MirrorManifest_t(const std::string_view parameters)
+    : m_parameters { parameters } {
+
+}
+
+///==============================================================================
+/// @brief Reads a manifest. If it doesn't exist or can't be read, the manifest
+///        stays empty. The files of a manifest written with other parameters
+///        are loaded too, so the outputs of the deleted ones can be removed.
+/// @param path Path of the manifest.
+/// @return true whether the files of the manifest were loaded and it was
+///         written with the same parameters.
+///==============================================================================
+bool
+MirrorManifest_t::load(const std::string_view path){
+
+    const std::string     magic { std::string { MIRROR_MANIFEST_MAGIC } + ' ' };
+          std::ifstream   file  { std::string { path } };
+          std::string     line  { "" };
+          ManifestEntry_t entry { };
+
+    if (!file.is_open() || !std::getline(file, line) || line.compare(0, magic.size(), magic) != 0)
+       return false;
+
+    const bool isSameParameters { line.compare(magic.size(), std::string::npos, m_parameters) == 0 };
+
+    while (std::getline(file, line)){
+       //size modified hash path. The path is the rest of the line, so it can have spaces.
+       const char*                  end  { line.data() + line.size() };
+       const std::from_chars_result size { std::from_chars(line.data(), end, entry.size) };
+
+       if (size.ec != std::errc { } || size.ptr == end)
+          continue;
+
+       const std::from_chars_result modified { std::from_chars(size.ptr + 1, end, entry.modified) };
+
+       if (modified.ec != std::errc { } || modified.ptr == end)
+          continue;
+
+       const std::from_chars_result hash { std::from_chars(modified.ptr + 1, end, entry.hash, 16) };
+
+       if (hash.ec != std::errc { } || hash.ptr == end || hash.ptr + 1 == end)
+          continue;
+
+       m_entries.insert_or_assign(std::string { hash.ptr + 1, end }, entry);
+    }
+
+    if (file.bad()){
+       m_entries.clear();
+       return false;
+    }
+
+    return isSameParameters;
+}
+
+///==============================================================================
+/// @brief Writes the manifest. It is written in a temporary file that replaces
+///        the old one at once, so a run that stops halfway leaves the previous
+///        manifest. The paths with a line break can't be stored, so those
+///        files are transformed again the next time.
+/// @param path Path of the manifest.
+///==============================================================================
+void
+MirrorManifest_t::save(const std::string_view path) const{
+
+    const std::string temporaryPath { std::string { path } + ".tmp" };
+          char        hash[17]      { };
+
+    {
+       std::ofstream file { temporaryPath, std::ios::binary | std::ios::trunc };
+
+       if (!file.is_open())
+          throw CaesarException_t(EXCEPTION_17);
+
+       file << MIRROR_MANIFEST_MAGIC << ' ' << m_parameters << '\n';
+
+       for (const auto& [relativePath, entry] : m_entries){
+          if (relativePath.find('\n') != std::string::npos)
+             continue;
+
+          const std::to_chars_result result { std::to_chars(hash, hash + sizeof(hash) - 1, entry.hash, 16) };
+
+          file << entry.size << ' ' << entry.modified << ' ';
+          file.write(hash, result.ptr - hash);
+          file << ' ' << relativePath << '\n';
+       }
+
+       file.flush();
+
+       if (!file){
+          std::remove(temporaryPath.c_str());
+          throw CaesarException_t(EXCEPTION_17);
+       }
+    }
+
+    if (std::rename(temporaryPath.c_str(), std::string { path }.c_str()) != 0){
+       std::remove(temporaryPath.c_str());
+       throw CaesarException_t(EXCEPTION_17);
+    }
+}
+
+///==============================================================================
+/// @brief Looks for a file in the manifest.
+/// @param relativePath Path of the file relative to the source directory.
+/// @return What is known about the file, or nullptr if it isn't in the manifest.
+///==============================================================================
+const ManifestEntry_t*
+MirrorManifest_t::find(const std::string& relativePath) const noexcept{
+
+    const auto found { m_entries.find(relativePath) };
+
+    return found != m_entries.end() ? &found->second : nullptr;
+}
+
+///==============================================================================
+/// @brief Adds a file to the manifest, or replaces what was known about it.
+/// @param relativePath Path of the file relative to the source directory.
+/// @param entry Size, modification time and hash of the file.
+///==============================================================================
+void
+MirrorManifest_t::set(const std::string& relativePath, const ManifestEntry_t& entry){
+
+    m_entries.insert_or_assign(relativePath, entry);
+}
+
+///==============================================================================
+/// @brief Gets the files of the manifest.
+/// @return m_entries that contains the files by their relative path.
+///==============================================================================
+const MirrorManifest_t::Entries_t&
+MirrorManifest_t::getEntries() const noexcept{
+
+    return m_entries;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace SherpadCaesar{
+
+/// @brief What is known about a source file of a mirror when it was transformed.
+struct ManifestEntry_t{
+                                                              /// @brief Size of the file in bytes.
+                                              std::uint64_t   size                { 0 };
+
+                                                              /// @brief Time of the last modification, in nanoseconds since the epoch.
+                                               std::int64_t   modified            { 0 };
+
+                                                              /// @brief FNV-1a hash of the content of the file.
+                                              std::uint64_t   hash                { 0 };
+};
+
+/// @class MirrorManifest_t
+/// @brief Keeps the files of a mirror that are already transformed, by their path relative to the source directory.
+///        It is stored as text in the output directory: a header with the parameters of the transformation and one line
+///        per file with its size, modification time, hash and path. With a manifest written with other parameters
+///        every file is transformed again.
+
+    class MirrorManifest_t{
+        public:
+            using Entries_t= std::unordered_map<std::string, ManifestEntry_t>;
+
+        private:
+                                                              /// @brief Parameters of the transformation: language, direction and level.
+                                                std::string   m_parameters;
+
+                                                              /// @brief Files already transformed, by their relative path.
+                                                  Entries_t   m_entries           { };
+
+        public:
+                explicit                                      MirrorManifest_t(const std::string_view);
+                                                              MirrorManifest_t(const MirrorManifest_t&)        = delete;
+                                                              MirrorManifest_t(      MirrorManifest_t&&)       = delete;
+                                                             ~MirrorManifest_t()                               = default;
+                                          MirrorManifest_t&   operator=(const MirrorManifest_t&)               = delete;
+                                          MirrorManifest_t&   operator=(      MirrorManifest_t&&)              = delete;
+                                                       bool   load(const std::string_view);
+                                                       void   save(const std::string_view)               const;
+                                     const ManifestEntry_t*   find(const std::string&)                   const noexcept;
+                                                       void   set(const std::string&, const ManifestEntry_t&);
+                                           const Entries_t&   getEntries()                             const noexcept;
+    };
+
+} // namespace SherpadCaesar
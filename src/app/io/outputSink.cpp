@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "../trace/probes.hpp"
+#include "../trace/traceRecorder.hpp"
+#include "outputSink.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the OutputSink_t class.
+/// @param fileDescriptor Descriptor where the output is written. It isn't
+///        closed by the sink.
+///==============================================================================
+OutputSink_t::OutputSink_t(const int fileDescriptor)
+    : m_fileDescriptor { fileDescriptor } {
+
+    const std::size_t pageSize { static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) };
+    struct stat       status   { };
+
+    m_bufferSize= OUTPUT_BUFFER_SIZE;
+
+#ifdef F_GETPIPE_SZ
+    if (::fstat(fileDescriptor, &status) == 0 && S_ISFIFO(status.st_mode)){
+       //A pipe as big as the buffer takes it in a single call. If it can't grow, the current size is used.
+       ::fcntl(fileDescriptor, F_SETPIPE_SZ, static_cast<int>(OUTPUT_BUFFER_SIZE));
+    }
+#endif
+
+    m_bufferSize= (m_bufferSize + pageSize - 1) / pageSize * pageSize;
+    m_memory    = static_cast<char*>(std::aligned_alloc(pageSize, m_bufferSize));
+
+    if (m_memory == nullptr)
+       throw std::bad_alloc { };
+}
+
+///==============================================================================
+/// @brief Constructor of the OutputSink_t class. Creates or truncates a file
+///        and writes the output in it.
+/// @param fileName Path of the output file.
+///==============================================================================
+OutputSink_t::OutputSink_t(const std::string& fileName)
+    : OutputSink_t { ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666) } {
+
+    if (m_fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_9);
+
+    m_ownsDescriptor= true;
+}
+
+///==============================================================================
+/// @brief Destructor of the OutputSink_t class. Writes what is pending; the
+///        errors are ignored here, flush() must be called to see them.
+///==============================================================================
+OutputSink_t::~OutputSink_t(){
+
+    try{
+       flush();
+    }
+    catch (...){
+    }
+
+    std::free(m_memory);
+
+    if (m_ownsDescriptor)
+       ::close(m_fileDescriptor);
+}
+
+///==============================================================================
+/// @brief Adds output. It is written when the buffer is full; big pieces are
+///        written directly, together with what is pending, with one writev(2).
+/// @param data Output to add.
+/// @param size Size of the output in bytes.
+///==============================================================================
+void
+OutputSink_t::write(const char* data, const std::size_t size){
+
+    std::size_t pivot { 0 };
+
+    if (size >= m_bufferSize){
+       writeAll(m_memory, m_used, data, size);
+       m_used= 0;
+       return;
+    }
+
+    while (pivot < size){
+       const std::size_t nCopy { std::min(size - pivot, m_bufferSize - m_used) };
+
+       std::memcpy(m_memory + m_used, data + pivot, nCopy);
+       m_used+= nCopy;
+       pivot += nCopy;
+
+       if (m_used == m_bufferSize)
+          drain();
+    }
+}
+
+///==============================================================================
+/// @brief Adds output.
+/// @param text Output to add.
+///==============================================================================
+void
+OutputSink_t::write(const std::string_view text){
+
+    write(text.data(), text.length());
+}
+
+///==============================================================================
+/// @brief Writes all the pending output.
+///==============================================================================
+void
+OutputSink_t::flush(){
+
+    if (m_used > 0)
+       drain();
+}
+
+///==============================================================================
+/// @brief Writes the buffer.
+///==============================================================================
+void
+OutputSink_t::drain(){
+
+    writeAll(m_memory, m_used, nullptr, 0);
+    m_used= 0;
+}
+
+///==============================================================================
+/// @brief Writes two pieces of output in order until they are complete.
+/// @param first First piece.
+/// @param firstSize Size of the first piece in bytes. It can be 0.
+/// @param second Second piece.
+/// @param secondSize Size of the second piece in bytes. It can be 0.
+///==============================================================================
+void
+OutputSink_t::writeAll(const char* first, const std::size_t firstSize, const char* second, const std::size_t secondSize){
+
+    struct iovec pieces[2] { { const_cast<char*>(first), firstSize }, { const_cast<char*>(second), secondSize } };
+    struct iovec* pending  { pieces };
+    int           nPending { 2 };
+
+    while (nPending > 0 && pending->iov_len == 0){
+       pending++;
+       nPending--;
+    }
+
+    while (nPending > 0){
+             TraceSpan_t                           span     { "writev", "io" };
+       const std::chrono::steady_clock::time_point start    { std::chrono::steady_clock::now() };
+       const ssize_t                               nWritten { ::writev(m_fileDescriptor, pending, nPending) };
+
+       span.setArgument("bytes", static_cast<long long>(pending[0].iov_len + (nPending > 1 ? pending[1].iov_len : 0)));
+       m_systemCalls++;
+       m_writeTime+= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+       if (nWritten < 0){
+          if (errno == EINTR)
+             continue;
+
+          throw CaesarException_t(EXCEPTION_8);
+       }
+
+       std::size_t nLeft { static_cast<std::size_t>(nWritten) };
+
+       m_bytesWritten+= nLeft;
+       CAESAR_PROBE2(output_flush, nLeft, m_bytesWritten);
+
+       while (nPending > 0 && nLeft >= pending->iov_len){
+          nLeft-= pending->iov_len;
+          pending++;
+          nPending--;
+       }
+
+       if (nPending > 0){
+          pending->iov_base= static_cast<char*>(pending->iov_base) + nLeft;
+          pending->iov_len-= nLeft;
+       }
+    }
+}
+
+///==============================================================================
+/// @brief Gets the number of bytes written.
+/// @return The bytes written since the sink was created.
+///==============================================================================
+std::size_t
+OutputSink_t::getBytesWritten() const noexcept{
+
+    return m_bytesWritten;
+}
+
+///==============================================================================
+/// @brief Gets the number of system calls used to write.
+/// @return The calls to writev(2).
+///==============================================================================
+std::size_t
+OutputSink_t::getSystemCalls() const noexcept{
+
+    return m_systemCalls;
+}
+
+///==============================================================================
+/// @brief Gets the time spent writing.
+/// @return The seconds spent in writev(2).
+///==============================================================================
+double
+OutputSink_t::getWriteTime() const noexcept{
+
+    return m_writeTime;
+}
+
+} // namespace SherpadCaesar
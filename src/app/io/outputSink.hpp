@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace SherpadCaesar{
+
+/// @class OutputSink_t
+/// @brief Writes the output to a file descriptor in big blocks with write(2)/writev(2), without the stream layer of
+///        std::cout. It only writes when the buffer is full or when it is flushed at the end of a block or a level.
+///        When the descriptor is a pipe, the pipe is grown to the size of the buffer, so every write fills it at
+///        once. The output is always copied to the pipe: pages moved with vmsplice(2) can still be referenced by the
+///        reader, with splice(2) or tee(2), after the sink has reused them.
+
+    class OutputSink_t{
+        private:
+                                                              /// @brief Descriptor where the output is written.
+                                                        int   m_fileDescriptor    { -1 };
+
+                                                              /// @brief Indicates whether the sink opened the descriptor and has to close it.
+                                                       bool   m_ownsDescriptor    { false };
+
+                                                              /// @brief Size of the buffer in bytes. It is a multiple of the page size.
+                                                std::size_t   m_bufferSize        { 0 };
+
+                                                              /// @brief Memory of the buffer, page-aligned.
+                                                       char*  m_memory            { nullptr };
+
+                                                              /// @brief Bytes used of the buffer.
+                                                std::size_t   m_used              { 0 };
+
+                                                              /// @brief Bytes written since the sink was created.
+                                                std::size_t   m_bytesWritten      { 0 };
+
+                                                              /// @brief Number of calls to writev(2).
+                                                std::size_t   m_systemCalls       { 0 };
+
+                                                              /// @brief Time spent in those calls, in seconds.
+                                                     double   m_writeTime         { 0.0 };
+
+                                                       void   drain();
+                                                       void   writeAll(const char*, const std::size_t, const char*, const std::size_t);
+
+        public:
+                explicit                                      OutputSink_t(const int);
+                explicit                                      OutputSink_t(const std::string&);
+                                                              OutputSink_t(const OutputSink_t&)                = delete;
+                                                              OutputSink_t(      OutputSink_t&&)               = delete;
+                                                             ~OutputSink_t();
+                                              OutputSink_t&   operator=(const OutputSink_t&)                   = delete;
+                                              OutputSink_t&   operator=(      OutputSink_t&&)                  = delete;
+                                                       void   write(const char*, const std::size_t);
+                                                       void   write(const std::string_view);
+                                                       void   flush();
+                                                std::size_t   getBytesWritten()                        const noexcept;
+                                                std::size_t   getSystemCalls()                         const noexcept;
+                                                     double   getWriteTime()                           const noexcept;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "sharedMapping.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the SharedMapping_t class. Creates or truncates an
+///        output file with the given size and maps it.
+/// @param fileName Path of the output file.
+/// @param size Size of the file in bytes.
+///==============================================================================
+SharedMapping_t::SharedMapping_t(const std::string& fileName, const std::size_t size)
+    : m_fileDescriptor { ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666) }, m_size { size } {
+
+    if (m_fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_9);
+
+    //The blocks are reserved at once instead of on every page fault. Only a file system that doesn't support it
+    //gets a sparse file: without space, a page fault on a block it can't give would kill the process with SIGBUS.
+    if (m_size > 0 && ::fallocate(m_fileDescriptor, 0, 0, static_cast<off_t>(m_size)) < 0 &&
+        ((errno != EOPNOTSUPP && errno != ENOSYS) || ::ftruncate(m_fileDescriptor, static_cast<off_t>(m_size)) < 0)){
+       ::close(m_fileDescriptor);
+       throw CaesarException_t(EXCEPTION_9);
+    }
+
+    map();
+}
+
+///==============================================================================
+/// @brief Constructor of the SharedMapping_t class. Maps an existing file to
+///        rewrite it in place.
+/// @param fileName Path of the file.
+///==============================================================================
+SharedMapping_t::SharedMapping_t(const std::string& fileName)
+    : m_fileDescriptor { ::open(fileName.c_str(), O_RDWR | O_CLOEXEC) } {
+
+    struct stat status { };
+
+    if (m_fileDescriptor < 0)
+       throw CaesarException_t(EXCEPTION_3);
+
+    if (::fstat(m_fileDescriptor, &status) < 0){
+       ::close(m_fileDescriptor);
+       throw CaesarException_t(EXCEPTION_3);
+    }
+
+    m_size= static_cast<std::size_t>(status.st_size);
+
+    map();
+}
+
+///==============================================================================
+/// @brief Destructor of the SharedMapping_t class. Removes the mapping and
+///        closes the file; the kernel writes the modified pages back.
+///==============================================================================
+SharedMapping_t::~SharedMapping_t(){
+
+    if (m_mapping != nullptr)
+       ::munmap(m_mapping, m_size);
+
+    ::close(m_fileDescriptor);
+}
+
+///==============================================================================
+/// @brief Maps the whole file for reading and writing.
+///==============================================================================
+void
+SharedMapping_t::map(){
+
+    if (m_size == 0)
+       return;
+
+    void* mapping { ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fileDescriptor, 0) };
+
+    if (mapping == MAP_FAILED){
+       ::close(m_fileDescriptor);
+       throw CaesarException_t(EXCEPTION_9);
+    }
+
+    ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+
+    m_mapping= static_cast<char*>(mapping);
+}
+
+///==============================================================================
+/// @brief Gets the content of the file.
+/// @return The start of the mapping, nullptr if the file is empty.
+///==============================================================================
+char*
+SharedMapping_t::getData() const noexcept{
+
+    return m_mapping;
+}
+
+///==============================================================================
+/// @brief Gets the size of the file.
+/// @return The size of the mapping in bytes.
+///==============================================================================
+std::size_t
+SharedMapping_t::getSize() const noexcept{
+
+    return m_size;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace SherpadCaesar{
+
+/// @class SharedMapping_t
+/// @brief Maps a file in memory for reading and writing with MAP_SHARED, so what is written in the mapping goes
+///        straight to the file without write(2) or an extra copy. It can create an output file of a known size,
+///        reserving its blocks with fallocate(2), or open an existing file to rewrite it in place.
+
+    class SharedMapping_t{
+        private:
+                                                              /// @brief Descriptor of the mapped file.
+                                                        int   m_fileDescriptor    { -1 };
+
+                                                              /// @brief Start of the mapping. nullptr if the file is empty.
+                                                       char*  m_mapping           { nullptr };
+
+                                                              /// @brief Size of the mapping in bytes.
+                                                std::size_t   m_size              { 0 };
+
+                                                       void   map();
+
+        public:
+                                                              SharedMapping_t(const std::string&, const std::size_t);
+                explicit                                      SharedMapping_t(const std::string&);
+                                                              SharedMapping_t(const SharedMapping_t&)          = delete;
+                                                              SharedMapping_t(      SharedMapping_t&&)         = delete;
+                                                             ~SharedMapping_t();
+                                           SharedMapping_t&   operator=(const SharedMapping_t&)                = delete;
+                                           SharedMapping_t&   operator=(      SharedMapping_t&&)               = delete;
+                                                       char*  getData()                                const noexcept;
+                                                std::size_t   getSize()                                const noexcept;
+    };
+
+} // namespace SherpadCaesar
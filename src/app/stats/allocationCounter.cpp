@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "allocationCounter.hpp"
+
+//The global operator new is replaced in the executable, not in libcaesar, so the programs that use the library keep
+//their own. Every other form of new and delete of the standard library ends in these ones.
+
+namespace SherpadCaesar {
+
+/// @brief Number of calls to operator new since the program started.
+static std::atomic<std::size_t> allocationCount { 0 };
+
+///==============================================================================
+/// @brief Allocates memory, calling the new handler until there is enough.
+/// @param size Bytes to allocate.
+/// @param alignment Alignment of the memory. 0 for the alignment of malloc.
+/// @return The memory.
+///==============================================================================
+static void*
+allocate(std::size_t size, const std::size_t alignment){
+
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (size == 0)
+       size= 1;
+
+    //aligned_alloc needs a size multiple of the alignment.
+    if (alignment > 0)
+       size= (size + alignment - 1) / alignment * alignment;
+
+    while (true){
+       void* memory { alignment > 0 ? std::aligned_alloc(alignment, size) : std::malloc(size) };
+
+       if (memory != nullptr)
+          return memory;
+
+       const std::new_handler handler { std::get_new_handler() };
+
+       if (handler == nullptr)
+          throw std::bad_alloc { };
+
+       handler();
+    }
+}
+
+///==============================================================================
+/// @brief Gets the number of heap allocations made with operator new.
+/// @return The calls to operator new since the program started.
+///==============================================================================
+std::size_t
+getAllocationCount() noexcept{
+
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+} // namespace SherpadCaesar
+
+void* operator new(const std::size_t size){
+
+    return SherpadCaesar::allocate(size, 0);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment){
+
+    return SherpadCaesar::allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory) noexcept{
+
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::size_t) noexcept{
+
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::align_val_t) noexcept{
+
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::size_t, const std::align_val_t) noexcept{
+
+    std::free(memory);
+}
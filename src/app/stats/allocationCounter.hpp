@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <cstddef>
+
+namespace SherpadCaesar{
+
+      std::size_t      getAllocationCount()                              noexcept;
+
+} // namespace SherpadCaesar
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "perfCounters.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Adds the counts and the time of another piece of work. An event that
+///        couldn't be counted in either of them stays at -1.
+/// @param other Counts to add.
+/// @return This sample.
+///==============================================================================
+PerfSample_t&
+PerfSample_t::operator+=(const PerfSample_t& other) noexcept{
+
+    for (int event= 0; event < NUM_PERF_EVENTS; event++)
+       counts[event]= (counts[event] < 0 || other.counts[event] < 0) ? std::max(counts[event], other.counts[event]) : counts[event] + other.counts[event];
+
+    seconds+= other.seconds;
+
+    return *this;
+}
+
+///==============================================================================
+/// @brief Constructor of the PerfCounters_t class. Opens every event, with the
+///        kernel if it is allowed and without it otherwise. Nothing is counted
+///        until start() is called.
+///==============================================================================
+PerfCounters_t::PerfCounters_t() noexcept{
+
+    static constexpr std::uint32_t TYPES[NUM_PERF_EVENTS]
+       { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE };
+
+    static constexpr unsigned long long CONFIGS[NUM_PERF_EVENTS]
+       { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES,
+         PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+         PERF_COUNT_HW_CACHE_LL  | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) };
+
+    m_fileDescriptors[cyclesEvent]= openEvent(TYPES[cyclesEvent], CONFIGS[cyclesEvent], false);
+
+    //With perf_event_paranoid at 2 or more only the user space can be counted.
+    if (m_fileDescriptors[cyclesEvent] < 0 && (errno == EACCES || errno == EPERM)){
+       m_isUserOnly= true;
+       m_fileDescriptors[cyclesEvent]= openEvent(TYPES[cyclesEvent], CONFIGS[cyclesEvent], true);
+    }
+
+    if (m_fileDescriptors[cyclesEvent] < 0){
+       m_error= errno;
+       return;
+    }
+
+    for (int event= cyclesEvent + 1; event < NUM_PERF_EVENTS; event++)
+       m_fileDescriptors[event]= openEvent(TYPES[event], CONFIGS[event], m_isUserOnly);
+}
+
+///==============================================================================
+/// @brief Destructor of the PerfCounters_t class. Closes the events.
+///==============================================================================
+PerfCounters_t::~PerfCounters_t(){
+
+    for (const int fileDescriptor : m_fileDescriptors)
+       if (fileDescriptor >= 0)
+          ::close(fileDescriptor);
+}
+
+///==============================================================================
+/// @brief Opens an event of the calling thread, disabled. The threads started
+///        later inherit it, so the chunks transformed by other threads count.
+/// @param type Type of the event.
+/// @param config Event of the type.
+/// @param isUserOnly Indicates whether the kernel is left out.
+/// @return The descriptor of the event, or -1 with errno set.
+///==============================================================================
+int
+PerfCounters_t::openEvent(const unsigned type, const unsigned long long config, const bool isUserOnly) const noexcept{
+
+    struct perf_event_attr attributes { };
+
+    attributes.size          = sizeof(attributes);
+    attributes.type          = type;
+    attributes.config        = config;
+    attributes.disabled      = 1;
+    attributes.inherit       = 1;
+    attributes.exclude_hv    = 1;
+    attributes.exclude_kernel= isUserOnly ? 1 : 0;
+    attributes.read_format   = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+///==============================================================================
+/// @brief Starts counting from zero.
+///==============================================================================
+void
+PerfCounters_t::start() noexcept{
+
+    for (const int fileDescriptor : m_fileDescriptors)
+       if (fileDescriptor >= 0){
+          ::ioctl(fileDescriptor, PERF_EVENT_IOC_RESET, 0);
+          ::ioctl(fileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+       }
+
+    m_start= std::chrono::steady_clock::now();
+}
+
+///==============================================================================
+/// @brief Stops counting and reads the counts since start().
+/// @return The counts, scaled when the events shared the counters, and the
+///         time. An event that wasn't counted at all is -1.
+///==============================================================================
+PerfSample_t
+PerfCounters_t::stop() noexcept{
+
+    PerfSample_t sample { };
+
+    sample.seconds= std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+    for (const int fileDescriptor : m_fileDescriptors)
+       if (fileDescriptor >= 0)
+          ::ioctl(fileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+    for (int event= 0; event < NUM_PERF_EVENTS; event++){
+       //Value, time enabled and time running, as asked by read_format.
+       std::uint64_t values[3] { };
+
+       if (m_fileDescriptors[event] < 0 || ::read(m_fileDescriptors[event], values, sizeof(values)) != sizeof(values) || values[2] == 0)
+          continue;
+
+       sample.counts[event]= static_cast<long long>(values[2] < values[1] ? static_cast<double>(values[0]) * values[1] / values[2] : values[0]);
+    }
+
+    return sample;
+}
+
+///==============================================================================
+/// @brief Indicates whether the hardware can be counted.
+/// @return true whether at least the cycles could be opened.
+///==============================================================================
+bool
+PerfCounters_t::isAvailable() const noexcept{
+
+    return m_fileDescriptors[cyclesEvent] >= 0;
+}
+
+///==============================================================================
+/// @brief Indicates whether only the user space is counted.
+/// @return m_isUserOnly that indicates whether the kernel is left out.
+///==============================================================================
+bool
+PerfCounters_t::isUserOnly() const noexcept{
+
+    return m_isUserOnly;
+}
+
+///==============================================================================
+/// @brief Gets why the hardware can't be counted.
+/// @return m_error that contains the errno of perf_event_open(2), or 0.
+///==============================================================================
+int
+PerfCounters_t::getError() const noexcept{
+
+    return m_error;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <chrono>
+
+namespace SherpadCaesar{
+
+/// @brief Hardware events counted by --perf.
+enum PerfEvent_t {cyclesEvent, instructionsEvent, branchMissesEvent, l1MissesEvent, llcMissesEvent};
+
+/// @brief Number of hardware events counted by --perf.
+constexpr int NUM_PERF_EVENTS { 5 };
+
+/// @brief Counts of the hardware events over a piece of work.
+struct PerfSample_t{
+                                                              /// @brief Count of every event, or -1 if it couldn't be counted.
+                     std::array<long long, NUM_PERF_EVENTS>   counts              { -1, -1, -1, -1, -1 };
+
+                                                              /// @brief Time of the work in seconds.
+                                                     double   seconds             { 0.0 };
+
+                                               PerfSample_t&  operator+=(const PerfSample_t&)                  noexcept;
+};
+
+/// @class PerfCounters_t
+/// @brief Hardware counters of the calling thread and of the threads it starts, read with perf_event_open(2). Every
+///        event is opened on its own, so an event the processor doesn't have is left out and the rest are still
+///        counted; when the kernel shares out the counters between more events than it has, the counts are scaled by
+///        the time every event was counted. The kernel is counted too when perf_event_paranoid allows it, and only
+///        the user space otherwise. Without a PMU, as in many virtual machines, nothing is counted and only the time
+///        is taken.
+
+    class PerfCounters_t{
+        private:
+                                                              /// @brief Descriptor of every event, or -1 if it couldn't be opened.
+                           std::array<int, NUM_PERF_EVENTS>   m_fileDescriptors   { -1, -1, -1, -1, -1 };
+
+                                                              /// @brief errno of the cycles when they couldn't be opened.
+                                                        int   m_error             { 0 };
+
+                                                              /// @brief Indicates whether only the user space is counted.
+                                                       bool   m_isUserOnly        { false };
+
+                                                              /// @brief When the counters were started.
+                      std::chrono::steady_clock::time_point   m_start             { };
+
+                                                        int   openEvent(const unsigned, const unsigned long long, const bool) const noexcept;
+
+        public:
+                                                              PerfCounters_t()                                 noexcept;
+                                                              PerfCounters_t(const PerfCounters_t&)            = delete;
+                                                              PerfCounters_t(      PerfCounters_t&&)           = delete;
+                                                             ~PerfCounters_t();
+                                            PerfCounters_t&   operator=(const PerfCounters_t&)                 = delete;
+                                            PerfCounters_t&   operator=(      PerfCounters_t&&)                = delete;
+                                                       void   start()                                          noexcept;
+                                               PerfSample_t   stop()                                           noexcept;
+                                                       bool   isAvailable()                            const noexcept;
+                                                       bool   isUserOnly()                             const noexcept;
+                                                        int   getError()                               const noexcept;
+    };
+
+} // namespace SherpadCaesar
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <iostream>
+#include <sys/resource.h>
+#include "../dat/utils/utf8.hpp"
+#include "../eng/languageTraits.hpp"
+#include "runStats.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Adds time to a phase.
+/// @param phase Phase of the run.
+/// @param seconds Time to add.
+///==============================================================================
+void
+RunStats_t::addTime(const StatsPhase_t phase, const double seconds) noexcept{
+
+    m_times[phase]+= seconds;
+}
+
+///==============================================================================
+/// @brief Gets the time of a phase.
+/// @param phase Phase of the run.
+/// @return The time of the phase in seconds.
+///==============================================================================
+double
+RunStats_t::getTime(const StatsPhase_t phase) const noexcept{
+
+    return m_times[phase];
+}
+
+///==============================================================================
+/// @brief Adds bytes read from the input.
+/// @param bytes Bytes read.
+///==============================================================================
+void
+RunStats_t::addBytesIn(const std::size_t bytes) noexcept{
+
+    m_bytesIn+= bytes;
+}
+
+///==============================================================================
+/// @brief Adds bytes written to the output.
+/// @param bytes Bytes written.
+///==============================================================================
+void
+RunStats_t::addBytesOut(const std::size_t bytes) noexcept{
+
+    m_bytesOut+= bytes;
+}
+
+///==============================================================================
+/// @brief Adds calls to operator new made while transforming.
+/// @param allocations Calls to add.
+///==============================================================================
+void
+RunStats_t::addAllocations(const std::size_t allocations) noexcept{
+
+    m_allocations+= allocations;
+}
+
+///==============================================================================
+/// @brief Counts the characters of a piece of the input by class. The letters
+///        of both alphabets are below 256, so a table of 256 classes answers.
+/// @param language Language of the alphabets.
+/// @param text Piece of the input. It must not cut a UTF-8 character.
+///==============================================================================
+void
+RunStats_t::countCharacters(const Language_t language, const std::string_view text) noexcept{
+
+    std::array<StatsCharacter_t, 256> classes   { };
+    char32_t                          codePoint { 0 };
+
+//==============================================================================
+//                         LAMBDA loadClasses
+//==============================================================================
+    auto loadClasses= [&classes](const auto& uppercase, const auto& lowercase){
+        for (std::size_t i= 0; i < uppercase.size(); i++){
+           classes[uppercase[i]]= capitalCharacter;
+           classes[lowercase[i]]= smallCharacter;
+        }
+    };
+
+    classes.fill(otherCharacter);
+
+    if (language == spanishLanguage)
+       loadClasses(LanguageTraits_t<spanishLanguage>::uppercase, LanguageTraits_t<spanishLanguage>::lowercase);
+    else
+       loadClasses(LanguageTraits_t<englishLanguage>::uppercase, LanguageTraits_t<englishLanguage>::lowercase);
+
+    for (std::size_t i= 0; i < text.size(); ){
+       const unsigned char byte { static_cast<unsigned char>(text[i]) };
+
+       //Most of the characters are ASCII: they are their own code point.
+       if (byte < 0x80){
+          m_characters[classes[byte]]++;
+          i++;
+          continue;
+       }
+
+       i+= decodeUTF8Character(text.data(), text.size(), i, codePoint);
+
+       if (codePoint >= UTF8_INVALID_BASE)
+          m_characters[invalidCharacter]++;
+       else
+          m_characters[codePoint < classes.size() ? classes[codePoint] : otherCharacter]++;
+    }
+
+    m_hasCharacters= true;
+}
+
+///==============================================================================
+/// @brief Writes the summary on the standard error. The time of the
+///        transformation doesn't include the writes, which are in the output.
+///==============================================================================
+void
+RunStats_t::write() const{
+
+    struct rusage usage   { };
+    const double  runTime { m_times[loadingPhase] + m_times[transformPhase] + m_times[outputPhase] };
+
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    std::cerr << "[+] Statistics of the run: \n";
+    std::cerr << "[+]    Parsing the arguments: " << m_times[parsingPhase] * 1e3 << " ms \n";
+    std::cerr << "[+]    Loading the input:     " << m_times[loadingPhase] * 1e3 << " ms \n";
+    std::cerr << "[+]    Transformation:        " << m_times[transformPhase] * 1e3 << " ms \n";
+    std::cerr << "[+]    Writing the output:    " << m_times[outputPhase] * 1e3 << " ms \n";
+    std::cerr << "[+]    Bytes in:  " << m_bytesIn << " \n";
+    std::cerr << "[+]    Bytes out: " << m_bytesOut << " \n";
+
+    if (m_bytesIn > 0 && runTime > 0.0)
+       std::cerr << "[+]    Throughput: " << m_bytesIn / runTime / 1e6 << " MB/s \n";
+
+    if (m_hasCharacters)
+       std::cerr << "[+]    Characters: " << m_characters[capitalCharacter] << " capital, " << m_characters[smallCharacter] << " small, "
+                 << m_characters[otherCharacter] << " other, " << m_characters[invalidCharacter] << " invalid UTF-8 \n";
+
+    std::cerr << "[+]    Peak RSS: " << usage.ru_maxrss << " KB \n";
+    std::cerr << "[+]    Heap allocations while transforming: " << m_allocations << " \n";
+    std::cerr << "[+] \n";
+}
+
+} // namespace SherpadCaesar
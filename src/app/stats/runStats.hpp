@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "../dat/utils/utils.hpp"
+
+namespace SherpadCaesar{
+
+/// @brief Phases of a run measured by --stats.
+enum StatsPhase_t {parsingPhase, loadingPhase, transformPhase, outputPhase};
+
+/// @brief Classes of the characters of the input counted by --stats.
+enum StatsCharacter_t {capitalCharacter, smallCharacter, otherCharacter, invalidCharacter};
+
+/// @class RunStats_t
+/// @brief Summary of a run written by --stats: the time of every phase, the bytes read and written, the characters of
+///        the input by class, the peak memory and the heap allocations made while transforming. The times are always
+///        taken, since they cost a few calls to the clock; the characters are only counted when the summary is
+///        written, after the run, so they don't change its times.
+
+    class RunStats_t{
+        private:
+                                                              /// @brief Time of every phase in seconds.
+                                     std::array<double, 4>    m_times             { };
+
+                                                              /// @brief Bytes read from the input.
+                                                std::size_t   m_bytesIn           { 0 };
+
+                                                              /// @brief Bytes written to the output.
+                                                std::size_t   m_bytesOut          { 0 };
+
+                                                              /// @brief Characters of the input by class.
+                              std::array<std::uint64_t, 4>    m_characters        { };
+
+                                                              /// @brief Indicates whether the characters of the input were counted.
+                                                       bool   m_hasCharacters     { false };
+
+                                                              /// @brief Calls to operator new while transforming.
+                                                std::size_t   m_allocations       { 0 };
+
+        public:
+                                                              RunStats_t()                                     = default;
+                                                              RunStats_t(const RunStats_t&)                    = delete;
+                                                              RunStats_t(      RunStats_t&&)                   = delete;
+                                                             ~RunStats_t()                                     = default;
+                                                RunStats_t&   operator=(const RunStats_t&)                     = delete;
+                                                RunStats_t&   operator=(      RunStats_t&&)                    = delete;
+                                                       void   addTime(const StatsPhase_t, const double)        noexcept;
+                                                     double   getTime(const StatsPhase_t)              const noexcept;
+                                                       void   addBytesIn(const std::size_t)                    noexcept;
+                                                       void   addBytesOut(const std::size_t)                   noexcept;
+                                                       void   addAllocations(const std::size_t)                noexcept;
+                                                       void   countCharacters(const Language_t, const std::string_view) noexcept;
+                                                       void   write()                                  const;
+    };
+
+} // namespace SherpadCaesar
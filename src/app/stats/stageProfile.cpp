@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../dat/data.hpp"
+#include "../dat/utils/utf8.hpp"
+#include "../eng/engine.hpp"
+#include "../io/outputSink.hpp"
+#include "stageProfile.hpp"
+
+namespace SherpadCaesar {
+
+///==============================================================================
+/// @brief Constructor of the StageProfile_t class. Opens the counters.
+/// @param data Data of the run.
+///==============================================================================
+StageProfile_t::StageProfile_t(const Data_t& data) noexcept
+    : m_data { data } {
+
+}
+
+///==============================================================================
+/// @brief Measures every stage of the transformation of the start of a text.
+/// @param input Text to transform. It must not cut a UTF-8 character.
+/// @param level Level of the transformation. It is positive.
+///==============================================================================
+void
+StageProfile_t::run(const std::string_view input, const int level){
+
+    const std::string_view text { input.substr(0, input.size() > MAX_BYTES ? findUTF8Boundary(input.data(), input.size(), MAX_BYTES) : input.size()) };
+
+    const Engine_t                                     engine       { m_data.getLanguage(), m_data.getDirection(), level, m_data.getIsa() };
+    //The path of a character at a time takes the level with the sign of the direction.
+    const int                                          signedLevel  { m_data.getDirection() == decryptDirection ? -level : level };
+          std::vector<std::string>                     characters   { };
+    //Type and position in the alphabet of every character, since DataCharacter_t can't be copied.
+          std::vector<std::pair<TypeCharacter_t, int>> found        { };
+          std::string                                  transformed  { };
+          std::vector<char>                            output       ( engine.getMaxOutputLength(text.size()) );
+          std::size_t                                  outputLength { 0 };
+
+    m_bytes+= text.size();
+
+    for (std::size_t first= 0; first < text.size(); ){
+       const std::size_t last { first + WINDOW_SIZE < text.size() ? findUTF8Boundary(text.data(), text.size(), first + WINDOW_SIZE) : text.size() };
+
+       characters.clear();
+       found.clear();
+       transformed.clear();
+
+       m_counters.start();
+
+       for (std::size_t i= first; i < last; ){
+          const int length { m_data.getUTF8CharLength(static_cast<unsigned char>(text[i])) };
+
+          characters.emplace_back(text.substr(i, length));
+          i+= length;
+       }
+
+       m_samples[decodeStage]+= m_counters.stop();
+       m_counters.start();
+
+       for (const std::string& c : characters){
+          DataCharacter_t dC { };
+
+          m_data.findCharacterData(c, dC);
+          found.emplace_back(dC.type, dC.position);
+       }
+
+       m_samples[lookupStage]+= m_counters.stop();
+       m_counters.start();
+
+       for (std::size_t i= 0; i < characters.size(); i++){
+          const auto& [type, position] { found[i] };
+
+          if (type == capitalLetter)
+             transformed+= m_data.getTransformedCharacter(m_data.getAlphabetUppercase(), position, signedLevel);
+          else if (type == smallLetter)
+             transformed+= m_data.getTransformedCharacter(m_data.getAlphabetLowercase(), position, signedLevel);
+          else
+             transformed+= characters[i];
+       }
+
+       m_samples[shiftStage]+= m_counters.stop();
+       first= last;
+    }
+
+    m_counters.start();
+    outputLength= engine.transform(text, output.data());
+    m_samples[transformStage]+= m_counters.stop();
+
+    OutputSink_t sink { std::string { "/dev/null" } };
+
+    m_counters.start();
+    sink.write(output.data(), outputLength);
+    sink.flush();
+    m_samples[outputStage]+= m_counters.stop();
+}
+
+///==============================================================================
+/// @brief Writes the counts of every stage on the standard error: cycles per
+///        byte, instructions per cycle and misses per kilobyte of the text. The
+///        events that couldn't be counted are written as '-'.
+///==============================================================================
+void
+StageProfile_t::write() const{
+
+    static constexpr const char* NAMES[NUM_STAGES] { "decode", "lookup", "shift", "transform", "output" };
+
+    const double kilobytes { m_bytes / 1024.0 };
+
+//==============================================================================
+//                         LAMBDA writeRatio
+//==============================================================================
+    auto writeRatio= [](const int width, const long long count, const double divisor){
+        if (count < 0 || divisor <= 0.0)
+           std::cerr << std::setw(width) << "-";
+        else
+           std::cerr << std::setw(width) << count / divisor;
+    };
+
+    std::cerr << "[+] Hardware counters of the stages over " << m_bytes << " bytes of the input";
+
+    if (!m_counters.isAvailable())
+       std::cerr << ": \n[+]    They aren't available here (perf_event_open: " << std::strerror(m_counters.getError()) << "), only the times are written. \n";
+    else
+       std::cerr << (m_counters.isUserOnly() ? " (user space only): \n" : ": \n");
+
+    std::cerr << "[+]    stage       cycles/B     IPC  br-miss/KB  L1D-miss/KB  LLC-miss/KB      MB/s \n";
+    std::cerr << std::fixed << std::setprecision(2);
+
+    for (int stage= 0; stage < NUM_STAGES; stage++){
+       const PerfSample_t& sample { m_samples[stage] };
+
+       std::cerr << "[+]    " << std::left << std::setw(9) << NAMES[stage] << std::right;
+       writeRatio(11, sample.counts[cyclesEvent], static_cast<double>(m_bytes));
+       writeRatio(8, sample.counts[instructionsEvent], static_cast<double>(sample.counts[cyclesEvent]));
+       writeRatio(12, sample.counts[branchMissesEvent], kilobytes);
+       writeRatio(13, sample.counts[l1MissesEvent], kilobytes);
+       writeRatio(13, sample.counts[llcMissesEvent], kilobytes);
+       writeRatio(10, static_cast<long long>(m_bytes), sample.seconds * 1e6);
+       std::cerr << " \n";
+    }
+
+    std::cerr << std::defaultfloat << "[+] \n";
+}
+
+} // namespace SherpadCaesar
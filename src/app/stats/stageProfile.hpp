@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include "perfCounters.hpp"
+
+namespace SherpadCaesar{
+
+class Data_t;
+
+/// @brief Stages of the transformation measured by --perf. The first three are the path of a character at a time
+///        that the engine replaced; the engine does all of them in a single pass.
+enum ProfileStage_t {decodeStage, lookupStage, shiftStage, transformStage, outputStage};
+
+/// @class StageProfile_t
+/// @brief Hardware counters of every stage of the transformation of a text, written by --perf. Every stage is run on
+///        its own over the same text, so its counts aren't mixed with the ones of the others: decode splits the text
+///        in characters with getUTF8CharLength(), lookup finds every character in the alphabets with
+///        findCharacterData(), shift gets the transformed letters with getTransformedCharacter(), transform runs the
+///        engine and output writes its result to /dev/null through the sink. The legacy stages go through the text
+///        in windows, so the characters of a window are all that is kept in memory, and only the first MAX_BYTES
+///        are measured, since they are slow.
+
+    class StageProfile_t{
+        private:
+                                                              /// @brief Number of stages.
+            static constexpr                            int   NUM_STAGES          { 5 };
+
+                                                              /// @brief Size of the windows of the legacy stages in bytes.
+            static constexpr                    std::size_t   WINDOW_SIZE         { 64 << 10 };
+
+                                                              /// @brief Data of the run: language, direction and alphabets.
+                                              const Data_t&   m_data;
+
+                                                              /// @brief Counters of the hardware.
+                                             PerfCounters_t   m_counters;
+
+                                                              /// @brief Counts of every stage.
+                       std::array<PerfSample_t, NUM_STAGES>   m_samples           { };
+
+                                                              /// @brief Bytes of the text measured.
+                                                std::size_t   m_bytes             { 0 };
+
+        public:
+                                                              /// @brief Biggest piece of the text measured, from its start, in bytes.
+            static constexpr                    std::size_t   MAX_BYTES           { 16 << 20 };
+
+                explicit                                      StageProfile_t(const Data_t&)                    noexcept;
+                                                              StageProfile_t(const StageProfile_t&)            = delete;
+                                                              StageProfile_t(      StageProfile_t&&)           = delete;
+                                                             ~StageProfile_t()                                 = default;
+                                            StageProfile_t&   operator=(const StageProfile_t&)                 = delete;
+                                            StageProfile_t&   operator=(      StageProfile_t&&)                = delete;
+                                                       void   run(const std::string_view, const int);
+                                                       void   write()                                  const;
+    };
+
+} // namespace SherpadCaesar
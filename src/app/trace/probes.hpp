@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+/// @brief USDT probes of the provider "caesar", for bpftrace, perf probe or SystemTap on a production host, even when
+///        the executable is stripped: the probes are ELF notes, not symbols. A probe is a single nop until a tracer is
+///        attached to it, and its arguments are only read then from registers or the stack. They are always compiled
+///        in, with sdt.hpp on x86-64 and AArch64 and with <sys/sdt.h> of SystemTap on other targets; a target with
+///        neither fails to build. With CAESAR_NO_PROBES the macros are empty and their arguments aren't evaluated.
+///
+///        job_start       (direction, level)           Start of a run. The level is 0 when there are many.
+///        job_end         (level, bytes)               End of a run, with the bytes written through the output.
+///        file_open       (path)                       Before the input file is opened to be loaded.
+///        file_read       (path, bytes)                After the input file is mapped or read.
+///        block_transform (level, bytes in, bytes out) Every block or chunk transformed at a level.
+///        bulk_level_start(level)                      Start of the output of a level of a bulk transformation.
+///        bulk_level      (level, bytes)               End of the output of a level of a bulk transformation.
+///        output_flush    (bytes, total bytes)         Every time the output is handed to the kernel.
+
+#ifndef CAESAR_NO_PROBES
+#  include "sdt.hpp"
+#  if defined(CAESAR_HAS_SDT)
+#     define CAESAR_PROBE1(name, a)       CAESAR_SDT_PROBE1(caesar, name, a)
+#     define CAESAR_PROBE2(name, a, b)    CAESAR_SDT_PROBE2(caesar, name, a, b)
+#     define CAESAR_PROBE3(name, a, b, c) CAESAR_SDT_PROBE3(caesar, name, a, b, c)
+#  elif defined(__has_include) && __has_include(<sys/sdt.h>)
+#     include <sys/sdt.h>
+#     define CAESAR_PROBE1(name, a)       DTRACE_PROBE1(caesar, name, a)
+#     define CAESAR_PROBE2(name, a, b)    DTRACE_PROBE2(caesar, name, a, b)
+#     define CAESAR_PROBE3(name, a, b, c) DTRACE_PROBE3(caesar, name, a, b, c)
+#  else
+#     error "The USDT probes aren't supported on this target. Build with NO_PROBES=1."
+#  endif
+#else
+#  define CAESAR_PROBE1(name, a)       do { (void)sizeof(a); } while (0)
+#  define CAESAR_PROBE2(name, a, b)    do { (void)sizeof(a); (void)sizeof(b); } while (0)
+#  define CAESAR_PROBE3(name, a, b, c) do { (void)sizeof(a); (void)sizeof(b); (void)sizeof(c); } while (0)
+#endif
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <type_traits>
+
+/// @brief Statically defined tracing probes in the format of <sys/sdt.h> of SystemTap, so the build doesn't depend on
+///        systemtap-sdt-dev. Every probe is a nop in the code and an ELF note in the section .note.stapsdt with the
+///        address of the nop, the provider, the name and where every argument is at that point, as "size@operand": a
+///        negative size is a signed argument. bpftrace, perf probe, SystemTap and readelf -n read these notes. The
+///        section .stapsdt.base lets the tools relocate the addresses of a prelinked or moved executable. Only ELF
+///        targets of 64 bits whose assembler prints operands the way the tools read them are supported.
+
+#if defined(__ELF__) && (defined(__x86_64__) || defined(__aarch64__))
+#  define CAESAR_HAS_SDT 1
+#endif
+
+#ifdef CAESAR_HAS_SDT
+
+/// @brief Size of an argument, negated for the "%n" operand modifier: it prints it negative when the type is signed.
+#define CAESAR_SDT_SIZE(x)  ((std::is_signed<typename std::decay<decltype(x)>::type>::value ? -1 : 1) * \
+                             -static_cast<int>(sizeof(typename std::decay<decltype(x)>::type)))
+
+/// @brief Operands of the argument n: its size as a constant and its value in a register, in memory or as a constant.
+#define CAESAR_SDT_ARG(n, x) [size##n] "n" (CAESAR_SDT_SIZE(x)), [arg##n] "nor" (x)
+
+#define CAESAR_SDT_PROBE(provider, name, arguments, ...)                                       \
+    __asm__ __volatile__ ("990: nop\n"                                                         \
+                          ".pushsection .note.stapsdt,\"?\",\"note\"\n"                        \
+                          ".balign 4\n"                                                        \
+                          ".4byte 992f-991f, 994f-993f, 3\n"                                   \
+                          "991: .asciz \"stapsdt\"\n"                                          \
+                          "992: .balign 4\n"                                                   \
+                          "993: .8byte 990b\n"                                                 \
+                          ".8byte _.stapsdt.base\n"                                            \
+                          ".8byte 0\n"                                                         \
+                          ".asciz \"" #provider "\"\n"                                         \
+                          ".asciz \"" #name "\"\n"                                             \
+                          ".asciz \"" arguments "\"\n"                                         \
+                          "994: .balign 4\n"                                                   \
+                          ".popsection\n"                                                      \
+                          ".ifndef _.stapsdt.base\n"                                           \
+                          ".pushsection .stapsdt.base,\"aG\",\"progbits\",.stapsdt.base,comdat\n" \
+                          ".weak _.stapsdt.base\n"                                             \
+                          ".hidden _.stapsdt.base\n"                                           \
+                          "_.stapsdt.base: .space 1\n"                                         \
+                          ".size _.stapsdt.base, 1\n"                                          \
+                          ".popsection\n"                                                      \
+                          ".endif\n"                                                           \
+                          :: __VA_ARGS__)
+
+#define CAESAR_SDT_PROBE1(provider, name, a)                                                   \
+    CAESAR_SDT_PROBE(provider, name, "%n[size1]@%[arg1]", CAESAR_SDT_ARG(1, a))
+
+#define CAESAR_SDT_PROBE2(provider, name, a, b)                                                \
+    CAESAR_SDT_PROBE(provider, name, "%n[size1]@%[arg1] %n[size2]@%[arg2]",                    \
+                     CAESAR_SDT_ARG(1, a), CAESAR_SDT_ARG(2, b))
+
+#define CAESAR_SDT_PROBE3(provider, name, a, b, c)                                             \
+    CAESAR_SDT_PROBE(provider, name, "%n[size1]@%[arg1] %n[size2]@%[arg2] %n[size3]@%[arg3]",  \
+                     CAESAR_SDT_ARG(1, a), CAESAR_SDT_ARG(2, b), CAESAR_SDT_ARG(3, c))
+
+#endif
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-v3.0
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <unistd.h>
+#include "../dat/excep/caesarException.hpp"
+#include "../dat/utils/utils.hpp"
+#include "traceRecorder.hpp"
+
+namespace SherpadCaesar {
+
+std::atomic<TraceRecorder_t*> TraceRecorder_t::s_active { nullptr };
+
+///==============================================================================
+/// @brief Constructor of the TraceRecorder_t class. Nothing is recorded until
+///        start() is called.
+/// @param path Path of the JSON file.
+///==============================================================================
+TraceRecorder_t::TraceRecorder_t(const std::string_view path)
+    : m_path { path }, m_origin { std::chrono::steady_clock::now() } {
+
+}
+
+///==============================================================================
+/// @brief Destructor of the TraceRecorder_t class. Stops the recording, so no
+///        span is added to a recorder that doesn't exist.
+///==============================================================================
+TraceRecorder_t::~TraceRecorder_t(){
+
+    stop();
+}
+
+///==============================================================================
+/// @brief Starts recording the spans of every thread. The thread that calls it
+///        is the main one of the trace.
+///==============================================================================
+void
+TraceRecorder_t::start() noexcept{
+
+    getTraceThread();
+    m_origin= std::chrono::steady_clock::now();
+    s_active.store(this, std::memory_order_release);
+}
+
+///==============================================================================
+/// @brief Stops recording. The threads that add spans must have finished.
+///==============================================================================
+void
+TraceRecorder_t::stop() noexcept{
+
+    TraceRecorder_t* expected { this };
+
+    s_active.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+}
+
+///==============================================================================
+/// @brief Adds a span. A span that doesn't fit in memory is lost, instead of
+///        stopping the run.
+/// @param event Span to add.
+///==============================================================================
+void
+TraceRecorder_t::add(const TraceEvent_t& event) noexcept{
+
+    try{
+       std::lock_guard<std::mutex> lock { m_mutex };
+
+       m_events.push_back(event);
+    }
+    catch (...){
+    }
+}
+
+///==============================================================================
+/// @brief Gets the time since the trace started.
+/// @return The nanoseconds since start() was called.
+///==============================================================================
+std::int64_t
+TraceRecorder_t::getTime() const noexcept{
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_origin).count();
+}
+
+///==============================================================================
+/// @brief Writes the spans as a JSON object of trace events: a complete event
+///        ("X") per span, in microseconds, and the name of every thread.
+///==============================================================================
+void
+TraceRecorder_t::write() const{
+
+    std::lock_guard<std::mutex> lock    { m_mutex };
+    std::ofstream               file    { m_path, std::ios::trunc };
+    std::set<int>               threads { };
+    const int                   process { static_cast<int>(::getpid()) };
+    char                        line[512];
+
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    std::snprintf(line, sizeof(line), "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": 1, \"args\": {\"name\": \"caesar\"}}", process);
+    file << line;
+
+    for (const TraceEvent_t& event : m_events){
+       threads.insert(event.thread);
+       std::snprintf(line, sizeof(line), ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %d, \"args\": {",
+                     event.name, event.category, event.start / 1e3, event.duration / 1e3, process, event.thread);
+       file << line;
+
+       for (int i= 0; i < MAX_TRACE_ARGUMENTS && event.argumentNames[i] != nullptr; i++){
+          std::snprintf(line, sizeof(line), "%s\"%s\": %lld", i > 0 ? ", " : "", event.argumentNames[i], event.arguments[i]);
+          file << line;
+       }
+
+       file << "}}";
+    }
+
+    for (const int thread : threads){
+       if (thread == 1)
+          std::snprintf(line, sizeof(line), ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": 1, \"args\": {\"name\": \"main\"}}", process);
+       else
+          std::snprintf(line, sizeof(line), ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"worker %d\"}}",
+                        process, thread, thread - 1);
+       file << line;
+    }
+
+    file << "\n]}\n";
+
+    if (!file.flush())
+       throw CaesarException_t(EXCEPTION_26);
+}
+
+///==============================================================================
+/// @brief Gets the number of the calling thread in the trace. The threads are
+///        numbered from 1 in the order they record their first span, so the
+///        numbers are short; the thread that starts the recorder is the 1.
+/// @return The number of the thread.
+///==============================================================================
+int
+getTraceThread() noexcept{
+
+    static std::atomic<int> nextThread { 1 };
+    thread_local const int  thread     { nextThread.fetch_add(1, std::memory_order_relaxed) };
+
+    return thread;
+}
+
+} // namespace SherpadCaesar
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-v3.0
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SherpadCaesar{
+
+/// @brief Most arguments of a span.
+constexpr int MAX_TRACE_ARGUMENTS { 2 };
+
+/// @brief Span of work of a thread, in the trace-event format of Chrome.
+struct TraceEvent_t{
+                                                              /// @brief Name and category of the span. They are literals, so they live until the trace is written.
+                                                 const char*  name                { nullptr };
+                                                 const char*  category            { nullptr };
+
+                                                              /// @brief Start and duration of the span, in nanoseconds since the trace started.
+                                               std::int64_t   start               { 0 };
+                                               std::int64_t   duration            { 0 };
+
+                                                              /// @brief Thread of the span, as given by getTraceThread().
+                                                        int   thread              { 0 };
+
+                                                              /// @brief Names and values of the arguments. The unused names are nullptr.
+               std::array<const char*, MAX_TRACE_ARGUMENTS>   argumentNames       { };
+                 std::array<long long, MAX_TRACE_ARGUMENTS>   arguments           { };
+};
+
+/// @class TraceRecorder_t
+/// @brief Timeline of a run written by --trace as trace-event JSON, which chrome://tracing and Perfetto show as a
+///        track per thread. The spans are recorded by TraceSpan_t only while a recorder is started, and nothing else
+///        reads the recorder: without one, a span costs a load and a branch, and with the CAESAR_NO_TRACE build flag
+///        it costs nothing at all.
+
+    class TraceRecorder_t{
+        private:
+                                                              /// @brief Recorder started, or nullptr.
+            static            std::atomic<TraceRecorder_t*>   s_active;
+
+                                                              /// @brief Path of the JSON file.
+                                                std::string   m_path;
+
+                                                              /// @brief When the trace started.
+                      std::chrono::steady_clock::time_point   m_origin;
+
+                                                              /// @brief Spans recorded, in the order they finished.
+                                  std::vector<TraceEvent_t>   m_events            { };
+
+                                                              /// @brief Protects the spans.
+                                         mutable std::mutex   m_mutex             { };
+
+        public:
+                explicit                                      TraceRecorder_t(const std::string_view);
+                                                              TraceRecorder_t(const TraceRecorder_t&)          = delete;
+                                                              TraceRecorder_t(      TraceRecorder_t&&)         = delete;
+                                                             ~TraceRecorder_t();
+                                           TraceRecorder_t&   operator=(const TraceRecorder_t&)                = delete;
+                                           TraceRecorder_t&   operator=(      TraceRecorder_t&&)               = delete;
+                                                       void   start()                                          noexcept;
+                                                       void   stop()                                           noexcept;
+                                                       void   add(const TraceEvent_t&)                         noexcept;
+                                               std::int64_t   getTime()                                const noexcept;
+                                                       void   write()                                  const;
+
+            static                         TraceRecorder_t*   getActive()                                      noexcept;
+    };
+
+      int              getTraceThread()                                  noexcept;
+
+///==============================================================================
+/// @brief Gets the recorder started, if any. It is read by every span, so it is
+///        inline.
+/// @return The recorder started, or nullptr.
+///==============================================================================
+inline TraceRecorder_t*
+TraceRecorder_t::getActive() noexcept{
+
+    return s_active.load(std::memory_order_acquire);
+}
+
+/// @class TraceSpan_t
+/// @brief Records the work of the current scope as a span of the recorder started, if any. It lives on the stack of
+///        the thread that does the work, from its start to its end. Its functions are inline, since they run once per
+///        block even when nothing is traced.
+
+    class TraceSpan_t{
+        private:
+#ifndef CAESAR_NO_TRACE
+                                                              /// @brief Recorder where the span is added, or nullptr.
+                                           TraceRecorder_t*   m_recorder;
+
+                                                              /// @brief Span being recorded.
+                                               TraceEvent_t   m_event             { };
+
+                                                              /// @brief Arguments already set.
+                                                        int   m_numArguments      { 0 };
+#endif
+
+        public:
+                                                              TraceSpan_t(const char*, const char*)            noexcept;
+                                                              TraceSpan_t(const TraceSpan_t&)                  = delete;
+                                                              TraceSpan_t(      TraceSpan_t&&)                 = delete;
+                                                             ~TraceSpan_t();
+                                               TraceSpan_t&   operator=(const TraceSpan_t&)                    = delete;
+                                               TraceSpan_t&   operator=(      TraceSpan_t&&)                   = delete;
+                                                       void   setArgument(const char*, const long long)        noexcept;
+    };
+
+#ifndef CAESAR_NO_TRACE
+
+///==============================================================================
+/// @brief Constructor of the TraceSpan_t class. Starts the span if a recorder
+///        is started.
+/// @param name Name of the span. It must be a literal.
+/// @param category Category of the span. It must be a literal.
+///==============================================================================
+inline
+TraceSpan_t::TraceSpan_t(const char* name, const char* category) noexcept
+    : m_recorder { TraceRecorder_t::getActive() } {
+
+    if (m_recorder != nullptr){
+       m_event.name    = name;
+       m_event.category= category;
+       m_event.start   = m_recorder->getTime();
+    }
+}
+
+///==============================================================================
+/// @brief Destructor of the TraceSpan_t class. Ends the span and adds it to
+///        the recorder.
+///==============================================================================
+inline
+TraceSpan_t::~TraceSpan_t(){
+
+    if (m_recorder != nullptr){
+       m_event.duration= m_recorder->getTime() - m_event.start;
+       m_event.thread  = getTraceThread();
+       m_recorder->add(m_event);
+    }
+}
+
+///==============================================================================
+/// @brief Sets an argument of the span, such as its bytes or its level. Only
+///        the first MAX_TRACE_ARGUMENTS are kept.
+/// @param name Name of the argument. It must be a literal.
+/// @param value Value of the argument.
+///==============================================================================
+inline void
+TraceSpan_t::setArgument(const char* name, const long long value) noexcept{
+
+    if (m_recorder != nullptr && m_numArguments < MAX_TRACE_ARGUMENTS){
+       m_event.argumentNames[m_numArguments]= name;
+       m_event.arguments[m_numArguments++]  = value;
+    }
+}
+
+#else
+
+inline TraceSpan_t::TraceSpan_t(const char*, const char*) noexcept { }
+inline TraceSpan_t::~TraceSpan_t() { }
+inline void TraceSpan_t::setArgument(const char*, const long long) noexcept { }
+
+#endif
+
+} // namespace SherpadCaesar